@@ -11,7 +11,7 @@ TAutoConsoleVariable<int32> GMovementImplementation(
 	TEXT("Which movement implementation to use for bots (needs bot respawn to take effect):\n")
 	TEXT("0 (default): vanilla Unreal object-oriented components\n")
 	TEXT("1: unrolled system in C++ with lightweight components\n")
-	/*TEXT("2: unrolled system in ISPC with lightweight components")*/,
+	TEXT("2: unrolled system in ISPC with lightweight components (work in progress: only MOVE_None bots run in the kernel, the rest fall back to 1)"),
 	ECVF_Default
 );
 
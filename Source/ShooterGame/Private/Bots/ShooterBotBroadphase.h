@@ -0,0 +1,356 @@
+#pragma once
+
+/** Upright capsule of a registered bot, as seen by FBotBroadphase. */
+struct FBotCapsule
+{
+	FVector Location = FVector::ZeroVector;
+	float Radius = 0.f;
+	float HalfHeight = 0.f;
+};
+
+/** First contact found by FBotBroadphase::SweepCapsule(). */
+struct FBotContact
+{
+	/** Index of the bot hit, INDEX_NONE if none. */
+	int32 Index = INDEX_NONE;
+	/** Fraction of the sweep at the time of contact, 0 if starting in penetration. */
+	float Time = 1.f;
+	/** Normal of the contact, pointing from the bot hit towards the swept capsule. */
+	FVector Normal = FVector::ZeroVector;
+	FVector ImpactPoint = FVector::ZeroVector;
+	/** Overlap depth when starting in penetration. */
+	float PenetrationDepth = 0.f;
+};
+
+/**
+ * Uniform grid over the XY locations of bot capsules, indexed like the movement system's Components. Bot-vs-bot
+ * contacts are resolved against it analytically, so that movement sweeps only need to hit world geometry.
+ * Game thread only.
+ */
+class FBotBroadphase
+{
+public:
+	/** Rebuilds the grid from scratch, Capsules being indexed like the movement system's Components. */
+	void Build(const TArray<FBotCapsule>& InCapsules, float InCellSize)
+	{
+		CellSize = FMath::Max(InCellSize, 1.f);
+		InvCellSize = 1.f / CellSize;
+		Cells.Reset();
+		Capsules = InCapsules;
+		CellKeys.SetNumUninitialized(Capsules.Num());
+		MaxRadius = 0.f;
+		MaxHalfHeight = 0.f;
+		for (int32 Index = 0; Index < Capsules.Num(); ++Index)
+		{
+			CellKeys[Index] = GetCellKey(Capsules[Index].Location);
+			Cells.FindOrAdd(CellKeys[Index]).Add(Index);
+			MaxRadius = FMath::Max(MaxRadius, Capsules[Index].Radius);
+			MaxHalfHeight = FMath::Max(MaxHalfHeight, Capsules[Index].HalfHeight);
+		}
+	}
+
+	void Empty()
+	{
+		Cells.Empty();
+		Capsules.Empty();
+		CellKeys.Empty();
+	}
+
+	bool Contains(int32 Index) const
+	{
+		return Capsules.IsValidIndex(Index);
+	}
+
+	/** Moves a bot, changing cells only if it crossed a cell boundary. */
+	void Update(int32 Index, const FVector& Location)
+	{
+		if (!Contains(Index))
+		{
+			return;
+		}
+		Capsules[Index].Location = Location;
+		const uint64 Key = GetCellKey(Location);
+		if (Key != CellKeys[Index])
+		{
+			RemoveFromCell(Index);
+			CellKeys[Index] = Key;
+			Cells.FindOrAdd(Key).Add(Index);
+		}
+	}
+
+	/** Mirrors the movement system's swap-and-pop of a component. */
+	void RemoveSwap(int32 Index)
+	{
+		if (!Contains(Index))
+		{
+			return;
+		}
+		RemoveFromCell(Index);
+		const int32 Last = Capsules.Num() - 1;
+		if (Index != Last)
+		{
+			TArray<int32>& LastCell = Cells.FindChecked(CellKeys[Last]);
+			LastCell[LastCell.Find(Last)] = Index;
+			Capsules[Index] = Capsules[Last];
+			CellKeys[Index] = CellKeys[Last];
+		}
+		Capsules.RemoveAt(Last, 1, false);
+		CellKeys.RemoveAt(Last, 1, false);
+	}
+
+	/**
+	 * Finds the first bot other than Index that the capsule of bot Index touches when moved by Delta. Starting in
+	 * penetration only counts if Delta moves further in. Returns false if the move is free of bots.
+	 */
+	bool SweepCapsule(int32 Index, const FVector& Delta, FBotContact& OutContact) const
+	{
+		const FBotCapsule& Self = Capsules[Index];
+		const FVector Start = Self.Location;
+		const FVector End = Start + Delta;
+		const float Reach = Self.Radius + MaxRadius;
+
+		const int32 MinX = FMath::FloorToInt((FMath::Min(Start.X, End.X) - Reach) * InvCellSize);
+		const int32 MaxX = FMath::FloorToInt((FMath::Max(Start.X, End.X) + Reach) * InvCellSize);
+		const int32 MinY = FMath::FloorToInt((FMath::Min(Start.Y, End.Y) - Reach) * InvCellSize);
+		const int32 MaxY = FMath::FloorToInt((FMath::Max(Start.Y, End.Y) + Reach) * InvCellSize);
+		const float MinZ = FMath::Min(Start.Z, End.Z) - Self.HalfHeight - MaxHalfHeight;
+		const float MaxZ = FMath::Max(Start.Z, End.Z) + Self.HalfHeight + MaxHalfHeight;
+
+		OutContact = FBotContact();
+		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		{
+			for (int32 X = MinX; X <= MaxX; ++X)
+			{
+				const TArray<int32>* Cell = Cells.Find(MakeCellKey(X, Y));
+				if (Cell == nullptr)
+				{
+					continue;
+				}
+				for (const int32 OtherIndex : *Cell)
+				{
+					const FBotCapsule& Other = Capsules[OtherIndex];
+					if (OtherIndex == Index || Other.Location.Z < MinZ || Other.Location.Z > MaxZ)
+					{
+						continue;
+					}
+					float Time;
+					if (SweepAgainst(Self, Delta, Other, OutContact.Time, Time) && (OutContact.Index == INDEX_NONE || Time < OutContact.Time))
+					{
+						OutContact.Index = OtherIndex;
+						OutContact.Time = Time;
+					}
+				}
+			}
+		}
+
+		if (OutContact.Index == INDEX_NONE)
+		{
+			return false;
+		}
+
+		const FBotCapsule& Other = Capsules[OutContact.Index];
+		const FVector Location = Start + Delta * OutContact.Time;
+		float Distance;
+		OutContact.Normal = GetSeparation(Self, Location, Other, Distance);
+		if (OutContact.Normal.IsZero())
+		{
+			OutContact.Normal = -Delta.GetSafeNormal();
+		}
+		OutContact.PenetrationDepth = FMath::Max(0.f, Self.Radius + Other.Radius - Distance);
+		OutContact.ImpactPoint = FVector(Other.Location.X, Other.Location.Y, GetClosestAxisZ(Other, Location.Z)) + OutContact.Normal * Other.Radius;
+		return true;
+	}
+
+	/** Whether a capsule at Location overlaps any bot other than IgnoreIndex, for encroachment tests. */
+	bool OverlapCapsule(int32 IgnoreIndex, const FVector& Location, float Radius, float HalfHeight) const
+	{
+		FBotCapsule Self;
+		Self.Location = Location;
+		Self.Radius = Radius;
+		Self.HalfHeight = HalfHeight;
+		const float Reach = Radius + MaxRadius;
+
+		const int32 MinX = FMath::FloorToInt((Location.X - Reach) * InvCellSize);
+		const int32 MaxX = FMath::FloorToInt((Location.X + Reach) * InvCellSize);
+		const int32 MinY = FMath::FloorToInt((Location.Y - Reach) * InvCellSize);
+		const int32 MaxY = FMath::FloorToInt((Location.Y + Reach) * InvCellSize);
+		const float MinZ = Location.Z - HalfHeight - MaxHalfHeight;
+		const float MaxZ = Location.Z + HalfHeight + MaxHalfHeight;
+
+		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		{
+			for (int32 X = MinX; X <= MaxX; ++X)
+			{
+				const TArray<int32>* Cell = Cells.Find(MakeCellKey(X, Y));
+				if (Cell == nullptr)
+				{
+					continue;
+				}
+				for (const int32 OtherIndex : *Cell)
+				{
+					const FBotCapsule& Other = Capsules[OtherIndex];
+					if (OtherIndex == IgnoreIndex || Other.Location.Z < MinZ || Other.Location.Z > MaxZ)
+					{
+						continue;
+					}
+					float Distance;
+					GetSeparation(Self, Location, Other, Distance);
+					if (Distance < Radius + Other.Radius - ContactTolerance)
+					{
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+private:
+	/** Distance below which capsules count as touching. */
+	static constexpr float ContactTolerance = 0.01f;
+
+	static uint64 MakeCellKey(int32 X, int32 Y)
+	{
+		return ((uint64)(uint32)X << 32) | (uint32)Y;
+	}
+
+	uint64 GetCellKey(const FVector& Location) const
+	{
+		return MakeCellKey(FMath::FloorToInt(Location.X * InvCellSize), FMath::FloorToInt(Location.Y * InvCellSize));
+	}
+
+	void RemoveFromCell(int32 Index)
+	{
+		TArray<int32>& Cell = Cells.FindChecked(CellKeys[Index]);
+		Cell.RemoveSingleSwap(Index, false);
+		if (Cell.Num() == 0)
+		{
+			Cells.Remove(CellKeys[Index]);
+		}
+	}
+
+	/** Z of the point on Capsule's axis segment closest to height Z. */
+	static float GetClosestAxisZ(const FBotCapsule& Capsule, float Z)
+	{
+		const float SegmentHalfLength = FMath::Max(0.f, Capsule.HalfHeight - Capsule.Radius);
+		return FMath::Clamp(Z, Capsule.Location.Z - SegmentHalfLength, Capsule.Location.Z + SegmentHalfLength);
+	}
+
+	/** Direction from Other's axis to Self's axis (placed at Location) and the distance between the axes. */
+	static FVector GetSeparation(const FBotCapsule& Self, const FVector& Location, const FBotCapsule& Other, float& OutDistance)
+	{
+		// Both capsules are upright, so the axes are separated horizontally and by the vertical gap between the segments.
+		const float SelfSegment = FMath::Max(0.f, Self.HalfHeight - Self.Radius);
+		const float OtherSegment = FMath::Max(0.f, Other.HalfHeight - Other.Radius);
+		const float DeltaZ = Location.Z - Other.Location.Z;
+		const float GapZ = FMath::Max(0.f, FMath::Abs(DeltaZ) - SelfSegment - OtherSegment);
+		const FVector Separation(Location.X - Other.Location.X, Location.Y - Other.Location.Y, DeltaZ >= 0.f ? GapZ : -GapZ);
+		OutDistance = Separation.Size();
+		return OutDistance > KINDA_SMALL_NUMBER ? Separation / OutDistance : FVector::ZeroVector;
+	}
+
+	/**
+	 * Time of first contact of Self moved by Delta with Other, solved exactly. The vertical gap between the segments is
+	 * linear in time between the times Self's segment starts or stops overlapping Other's in Z, so on each such piece
+	 * the squared axis distance is a quadratic and the contact is its first root.
+	 */
+	static bool SweepAgainst(const FBotCapsule& Self, const FVector& Delta, const FBotCapsule& Other, float MaxTime, float& OutTime)
+	{
+		const float ContactDistance = Self.Radius + Other.Radius;
+
+		float Distance;
+		const FVector StartNormal = GetSeparation(Self, Self.Location, Other, Distance);
+		if (Distance <= ContactDistance + ContactTolerance)
+		{
+			// Already touching. Let the bot slide or move out, block it from moving further in.
+			OutTime = 0.f;
+			return (Delta | StartNormal) < 0.f || StartNormal.IsZero();
+		}
+		if (Delta.SizeSquared() < FMath::Square(KINDA_SMALL_NUMBER))
+		{
+			return false;
+		}
+
+		const float SegmentsHalfLength = FMath::Max(0.f, Self.HalfHeight - Self.Radius) + FMath::Max(0.f, Other.HalfHeight - Other.Radius);
+		const float StartZ = Self.Location.Z - Other.Location.Z;
+
+		// Pieces of [0, MaxTime] split where StartZ + Delta.Z * t crosses +/-SegmentsHalfLength.
+		float Bounds[4] = { 0.f, MaxTime, MaxTime, MaxTime };
+		int32 NumBounds = 1;
+		if (FMath::Abs(Delta.Z) > KINDA_SMALL_NUMBER)
+		{
+			const float Crossings[2] = { (SegmentsHalfLength - StartZ) / Delta.Z, (-SegmentsHalfLength - StartZ) / Delta.Z };
+			for (const float Crossing : Crossings)
+			{
+				if (Crossing > 0.f && Crossing < MaxTime)
+				{
+					Bounds[NumBounds++] = Crossing;
+				}
+			}
+			if (NumBounds == 3 && Bounds[2] < Bounds[1])
+			{
+				Swap(Bounds[1], Bounds[2]);
+			}
+		}
+		Bounds[NumBounds] = MaxTime;
+
+		for (int32 Piece = 0; Piece < NumBounds; ++Piece)
+		{
+			const float PieceStart = Bounds[Piece];
+			const float PieceEnd = Bounds[Piece + 1];
+			if (PieceEnd <= PieceStart)
+			{
+				continue;
+			}
+
+			// Vertical gap as GapStart + GapRate * t, signed so that it is linear across the piece.
+			const float MidZ = StartZ + Delta.Z * 0.5f * (PieceStart + PieceEnd);
+			float GapStart = 0.f;
+			float GapRate = 0.f;
+			if (MidZ > SegmentsHalfLength)
+			{
+				GapStart = StartZ - SegmentsHalfLength;
+				GapRate = Delta.Z;
+			}
+			else if (MidZ < -SegmentsHalfLength)
+			{
+				GapStart = -StartZ - SegmentsHalfLength;
+				GapRate = -Delta.Z;
+			}
+
+			// |Start + Rate * t|^2 = ContactDistance^2
+			const FVector Start(Self.Location.X - Other.Location.X, Self.Location.Y - Other.Location.Y, GapStart);
+			const FVector Rate(Delta.X, Delta.Y, GapRate);
+			const float A = Rate.SizeSquared();
+			const float B = 2.f * (Start | Rate);
+			const float C = Start.SizeSquared() - FMath::Square(ContactDistance);
+			if (A < SMALL_NUMBER)
+			{
+				continue;
+			}
+			const float Discriminant = B * B - 4.f * A * C;
+			if (Discriminant < 0.f)
+			{
+				continue;
+			}
+			// Outside at the start of the piece, so the smaller root is where the capsules first touch.
+			const float Time = (-B - FMath::Sqrt(Discriminant)) / (2.f * A);
+			if (Time >= PieceStart && Time <= PieceEnd)
+			{
+				OutTime = Time;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	TMap<uint64, TArray<int32>> Cells;
+	TArray<FBotCapsule> Capsules;
+	/** Cell each capsule is filed under. */
+	TArray<uint64> CellKeys;
+	float CellSize = 1.f;
+	float InvCellSize = 1.f;
+	/** Largest capsule in the grid, bounds how far from a swept capsule other bots' cells are searched. */
+	float MaxRadius = 0.f;
+	float MaxHalfHeight = 0.f;
+};
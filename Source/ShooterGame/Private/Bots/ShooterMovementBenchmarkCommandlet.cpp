@@ -0,0 +1,183 @@
+#include "ShooterGame.h"
+#include "Bots/ShooterMovementBenchmarkCommandlet.h"
+#include "Bots/ShooterUnrolledCppMovement.h"
+#include "ISPC/CppCallbackCounters.h"
+#include "ISPC/ISPCKernelTargets.h"
+#include "Components/BoxComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMovementBenchmark, Log, All);
+
+AShooterBenchmarkBot::AShooterBenchmarkBot(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UShooterUnrolledCppMovement>(ACharacter::CharacterMovementComponentName))
+{
+	// Input is fed directly by the commandlet, there's no controller.
+	GetCharacterMovement()->bRunPhysicsWithNoController = true;
+}
+
+UShooterMovementBenchmarkCommandlet::UShooterMovementBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = true;
+	LogToConsole = true;
+}
+
+namespace
+{
+	/** Spawns a static blocking box. The floor and the obstacles are all made of these. */
+	void SpawnBox(UWorld* World, const FVector& Location, const FVector& Extent)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+		UBoxComponent* Box = NewObject<UBoxComponent>(Actor);
+		Box->SetBoxExtent(Extent, false);
+		Box->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+		Box->SetMobility(EComponentMobility::Static);
+		Box->SetWorldLocation(Location);
+		Actor->SetRootComponent(Box);
+		Box->RegisterComponent();
+	}
+
+	void LogKernelTarget(int32 ISA, int32 GangWidth, double Seconds, int32 NumBots, int32 NumFrames)
+	{
+		UE_LOG(LogMovementBenchmark, Display, TEXT("ISPC target %s, gang width %d: %.1f ns/bot/frame, %.1f per-lane callbacks/frame, %.1f gang-wide callbacks/frame, %.1f%% lane utilisation in gang-wide callbacks"),
+			UShooterUnrolledCppMovementSystem::GetISPCTargetName(ISA),
+			GangWidth,
+			Seconds * 1e9 / ((double)NumBots * NumFrames),
+			(double)FCppCallbackCounters::LaneCalls / NumFrames,
+			(double)FCppCallbackCounters::GangCalls / NumFrames,
+			FCppCallbackCounters::GangCalls > 0 ? 100.0 * FCppCallbackCounters::GangActiveLanes / ((double)FCppCallbackCounters::GangCalls * GangWidth) : 0.0);
+	}
+}
+
+int32 UShooterMovementBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 NumBots = 256;
+	int32 NumFrames = 600;
+	int32 NumWarmupFrames = 60;
+	int32 Implementation = 2;
+	int32 NumBoxes = 256;
+	int32 Seed = 0;
+	float DeltaTime = 1.f / 30.f;
+	FParse::Value(*Params, TEXT("Bots="), NumBots);
+	FParse::Value(*Params, TEXT("Frames="), NumFrames);
+	FParse::Value(*Params, TEXT("Warmup="), NumWarmupFrames);
+	FParse::Value(*Params, TEXT("Impl="), Implementation);
+	FParse::Value(*Params, TEXT("Boxes="), NumBoxes);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("DeltaTime="), DeltaTime);
+	NumBots = FMath::Max(NumBots, 1);
+	NumFrames = FMath::Max(NumFrames, 1);
+	NumWarmupFrames = FMath::Max(NumWarmupFrames, 0);
+
+	if (Implementation != 1 && Implementation != 2)
+	{
+		UE_LOG(LogMovementBenchmark, Error, TEXT("Impl must be 1 (unrolled C++) or 2 (ISPC), got %d"), Implementation);
+		return 1;
+	}
+	IConsoleManager::Get().FindConsoleVariable(TEXT("ispc.MovementImplementation"))->Set(Implementation);
+	if (Implementation == 2 && (ispc::GetKernelMovementModes() & ~(1u << MOVE_None)) == 0)
+	{
+		UE_LOG(LogMovementBenchmark, Warning, TEXT("The ISPC kernel has no live movement physics yet: bots in any mode but MOVE_None fall back to the unrolled C++ PerformMovement(), so Impl=2 mostly measures that fallback"));
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("MovementBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	// A floor with a box soup on top of it. The low boxes make for steps, the high ones for walls.
+	FRandomStream Random(Seed);
+	const int32 GridSize = FMath::CeilToInt(FMath::Sqrt((float)NumBots));
+	const float ArenaHalfExtent = GridSize * 100.f + 1000.f;
+	SpawnBox(World, FVector(0.f, 0.f, -50.f), FVector(ArenaHalfExtent, ArenaHalfExtent, 50.f));
+	for (int32 Index = 0; Index < NumBoxes; ++Index)
+	{
+		const FVector Extent(Random.FRandRange(20.f, 200.f), Random.FRandRange(20.f, 200.f), Random.FRandRange(10.f, 120.f));
+		SpawnBox(World, FVector(Random.FRandRange(-ArenaHalfExtent, ArenaHalfExtent), Random.FRandRange(-ArenaHalfExtent, ArenaHalfExtent), Extent.Z), Extent);
+	}
+
+	// Bots start out in the air, so the first frames exercise falling and landing, too.
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	TArray<AShooterBenchmarkBot*> Bots;
+	TArray<FVector> Directions;
+	for (int32 Index = 0; Index < NumBots; ++Index)
+	{
+		const FVector Location((Index % GridSize - GridSize / 2) * 200.f, (Index / GridSize - GridSize / 2) * 200.f, 200.f);
+		if (AShooterBenchmarkBot* Bot = World->SpawnActor<AShooterBenchmarkBot>(Location, FRotator::ZeroRotator, SpawnParams))
+		{
+			Bots.Add(Bot);
+			Directions.Add(FVector::ForwardVector.RotateAngleAxis(Random.FRandRange(0.f, 360.f), FVector::UpVector));
+		}
+	}
+
+	UShooterUnrolledCppMovementSystem* System = UShooterUnrolledCppMovementSystem::FindForLevel(World->PersistentLevel);
+	if (System == nullptr || Bots.Num() == 0)
+	{
+		UE_LOG(LogMovementBenchmark, Error, TEXT("Failed to spawn the bots"));
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		return 1;
+	}
+
+	// Returns the movement system's cycles over the frames, with the callback counters counting them.
+	auto TickFrames = [&](int32 NumTickFrames)
+	{
+		FCppCallbackCounters::Reset();
+		FCppCallbackCounters::bEnabled = true;
+		uint64 Cycles = 0;
+		for (int32 Frame = 0; Frame < NumTickFrames; ++Frame)
+		{
+			// Wander around, turning a little every frame and jumping every now and then.
+			for (int32 Index = 0; Index < Bots.Num(); ++Index)
+			{
+				Directions[Index] = Directions[Index].RotateAngleAxis(Random.FRandRange(-10.f, 10.f), FVector::UpVector);
+				Bots[Index]->AddMovementInput(Directions[Index]);
+				if (Random.FRand() < 0.005f)
+				{
+					Bots[Index]->Jump();
+				}
+			}
+
+			World->Tick(LEVELTICK_All, DeltaTime);
+			Cycles += System->GetLastTickCycles();
+		}
+		FCppCallbackCounters::bEnabled = false;
+		return Cycles;
+	};
+
+	TickFrames(NumWarmupFrames);
+	const uint64 TotalCycles = TickFrames(NumFrames);
+
+	const double Seconds = FPlatformTime::ToSeconds64(TotalCycles);
+	UE_LOG(LogMovementBenchmark, Display, TEXT("ispc.MovementImplementation %d, %d bots, %d boxes, %d frames (+%d warmup) of %.4f s"),
+		Implementation, System->GetNumComponents(), NumBoxes, NumFrames, NumWarmupFrames, DeltaTime);
+	UE_LOG(LogMovementBenchmark, Display, TEXT("Movement system: %.1f ns/bot/frame, %.3f ms/frame"),
+		Seconds * 1e9 / ((double)System->GetNumComponents() * NumFrames), Seconds * 1e3 / NumFrames);
+	if (Implementation == 2)
+	{
+		LogKernelTarget(ispc::GetTargetISA(), ispc::GetProgramCount(), Seconds, System->GetNumComponents(), NumFrames);
+
+		// Multi-target builds: the same number of frames again on each target's own kernels.
+		for (const FISPCKernelTarget& Target : ISPCKernelTargets::GetCompiled())
+		{
+			if (!ISPCKernelTargets::IsSupported(Target))
+			{
+				UE_LOG(LogMovementBenchmark, Display, TEXT("ISPC target %s: not supported by this CPU, skipped"), UShooterUnrolledCppMovementSystem::GetISPCTargetName(Target.ISA));
+				continue;
+			}
+			ISPCKernelTargets::Force(&Target);
+			const uint64 TargetCycles = TickFrames(NumFrames);
+			ISPCKernelTargets::Force(nullptr);
+			LogKernelTarget(Target.ISA, Target.GetProgramCount(), FPlatformTime::ToSeconds64(TargetCycles), System->GetNumComponents(), NumFrames);
+		}
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return 0;
+}
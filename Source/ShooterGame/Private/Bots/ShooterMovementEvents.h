@@ -0,0 +1,168 @@
+#pragma once
+
+class UShooterUnrolledCppMovement;
+class ACharacter;
+
+/** Notifications from the movement code into actor code, queued and delivered after the system tick. */
+enum class EMovementEventType : uint8
+{
+	/** ACharacter::OnCharacterMovementUpdated. */
+	MovementUpdated,
+	/** ACharacter::Landed(). */
+	Landed,
+	/** ACharacter::NotifyJumpApex(). */
+	JumpApex,
+	/** HandleImpact(): MoveBlockedBy(), path following, bumped pawns and impact forces. */
+	Impact,
+	/** The warning logged by OnCharacterStuckInGeometry(). */
+	StuckInGeometry,
+	/** ACharacter::OnMovementModeChanged(). */
+	MovementModeChanged,
+
+	Count
+};
+
+/** One queued notification. Only the fields of its type are valid; slots are reused without being cleared. */
+struct FMovementEvent
+{
+	EMovementEventType Type;
+	/** MovementModeChanged. */
+	uint8 PreviousMovementMode;
+	uint8 PreviousCustomMode;
+	/** StuckInGeometry: whether Hit is valid. */
+	bool bHasHit;
+	/** SystemIndex of the component, events are delivered in component order. */
+	int32 ComponentIndex;
+	UShooterUnrolledCppMovement* Comp;
+	ACharacter* CharacterOwner;
+	/** MovementUpdated: DeltaTime. Impact: TimeSlice. */
+	float Time;
+	/** StuckInGeometry: warnings suppressed since the last one. */
+	int32 Count;
+	/** MovementUpdated: OldLocation. */
+	FVector Location;
+	/** MovementUpdated: OldVelocity. Impact, StuckInGeometry: velocity at the time of the event. */
+	FVector Velocity;
+	/** Impact: acceleration the impact forces are computed from. */
+	FVector Acceleration;
+	/** Impact: MoveDelta. */
+	FVector Delta;
+	/** Landed, Impact, StuckInGeometry. */
+	FHitResult Hit;
+};
+
+/**
+ * Lock-free multi-producer, single-consumer queue of movement events. Producers (the serial tick, parallel movement
+ * workers, ISPC tasks) claim a slot with a single atomic increment. Slots are allocated in chunks on first use and
+ * kept for later ticks. The owning system drains the queue once all producers are done.
+ */
+class FMovementEventQueue
+{
+public:
+	/** Queue of the system currently ticking, null outside of its tick and while it delivers events. */
+	static FMovementEventQueue* Active;
+
+	/** Mask of (1 << EMovementEventType) to deliver immediately instead of queueing. */
+	uint32 ImmediateTypes = 0;
+
+	FMovementEventQueue()
+	{
+		FMemory::Memzero((void*)Chunks, sizeof(Chunks));
+	}
+
+	~FMovementEventQueue()
+	{
+		for (FMovementEvent* Chunk : Chunks)
+		{
+			delete[] Chunk;
+		}
+	}
+
+	FMovementEventQueue(const FMovementEventQueue&) = delete;
+	FMovementEventQueue& operator=(const FMovementEventQueue&) = delete;
+
+	/**
+	 * Queues an event in the active queue, Fill(FMovementEvent&) writing its payload in place. Safe on any thread.
+	 * Returns false if there is no active queue, the type is delivered immediately or the queue is full; the caller
+	 * then delivers the event itself.
+	 */
+	template<typename FillFuncType>
+	static bool TryQueue(EMovementEventType Type, UShooterUnrolledCppMovement* Comp, int32 ComponentIndex, ACharacter* CharacterOwner, const FillFuncType& Fill)
+	{
+		FMovementEventQueue* Queue = Active;
+		if (Queue == nullptr || (Queue->ImmediateTypes & (1u << (uint32)Type)) != 0)
+		{
+			return false;
+		}
+
+		FMovementEvent* Event = Queue->Claim();
+		if (Event == nullptr)
+		{
+			return false;
+		}
+		Event->Type = Type;
+		Event->ComponentIndex = ComponentIndex;
+		Event->Comp = Comp;
+		Event->CharacterOwner = CharacterOwner;
+		Fill(*Event);
+		return true;
+	}
+
+	/** Calls Deliver(FMovementEvent&) for all queued events in component order and empties the queue. Must not overlap TryQueue(). */
+	template<typename FuncType>
+	int32 Drain(const FuncType& Deliver)
+	{
+		const int32 Num = FMath::Min<int32>(NumClaimed, Capacity);
+		// A component's events come from one thread at a time, so within a component, slot order is emission order.
+		SortKeys.Reset(Num);
+		for (int32 Slot = 0; Slot < Num; ++Slot)
+		{
+			SortKeys.Add(((uint64)(uint32)GetSlot(Slot).ComponentIndex << 32) | (uint32)Slot);
+		}
+		SortKeys.Sort();
+
+		for (const uint64 Key : SortKeys)
+		{
+			Deliver(GetSlot((int32)(uint32)Key));
+		}
+		NumClaimed = 0;
+		return Num;
+	}
+
+private:
+	static const int32 ChunkSize = 256;
+	static const int32 MaxChunks = 256;
+	static const int32 Capacity = ChunkSize * MaxChunks;
+
+	FMovementEvent* Claim()
+	{
+		const int32 Slot = FPlatformAtomics::InterlockedIncrement(&NumClaimed) - 1;
+		if (Slot >= Capacity)
+		{
+			return nullptr;
+		}
+
+		FMovementEvent* volatile& Chunk = Chunks[Slot / ChunkSize];
+		if (Chunk == nullptr)
+		{
+			// First use of this chunk; whoever loses the race frees its allocation.
+			FMovementEvent* NewChunk = new FMovementEvent[ChunkSize];
+			if (FPlatformAtomics::InterlockedCompareExchangePointer((void**)&Chunk, NewChunk, nullptr) != nullptr)
+			{
+				delete[] NewChunk;
+			}
+		}
+		return &Chunk[Slot % ChunkSize];
+	}
+
+	FMovementEvent& GetSlot(int32 Slot) const
+	{
+		return Chunks[Slot / ChunkSize][Slot % ChunkSize];
+	}
+
+	/** Number of slots claimed this tick, may exceed Capacity once the queue has overflowed. */
+	volatile int32 NumClaimed = 0;
+	FMovementEvent* volatile Chunks[MaxChunks];
+	/** Scratch for Drain(): (ComponentIndex, Slot) pairs. */
+	TArray<uint64> SortKeys;
+};
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Async/TaskGraphInterfaces.h"
+
+/** Storage for the result of a callback marshalled to the game thread. */
+template<typename ResultType>
+struct TGameThreadCallbackResult
+{
+	ResultType Value;
+	template<typename FuncType> void Run(FuncType& Func) { Value = Func(); }
+	ResultType Get() const { return Value; }
+};
+
+template<>
+struct TGameThreadCallbackResult<void>
+{
+	template<typename FuncType> void Run(FuncType& Func) { Func(); }
+	void Get() const {}
+};
+
+namespace ParallelMovement
+{
+	/** Adds a callback marshalled by RunOnGameThread() to the "Parallel Game Thread" stats. Game thread only. */
+	void RecordGameThreadCallback(uint32 Cycles);
+}
+
+/**
+ * Runs game-thread-only code. When called from a task graph worker (parallel movement tick), Func is
+ * dispatched to the game thread, which services it while waiting for the movement tasks to complete.
+ *
+ * Known limitation: the game thread runs these one at a time, and the worker blocks until its callback is done.
+ * MoveUpdatedComponent(), SafeMoveUpdatedComponent() and StepUp() are marshalled this way, so the moves of all
+ * bots are serialized and only the math around them runs in parallel. "UnrCpp Char Parallel Game Thread Time"
+ * against "UnrCpp Char Parallel Tick" in stat UnrCppChar is the serialized share.
+ */
+template<typename FuncType>
+static auto RunOnGameThread(FuncType Func) -> decltype(Func())
+{
+	if (IsInGameThread())
+	{
+		return Func();
+	}
+
+	TGameThreadCallbackResult<decltype(Func())> Result;
+	FGraphEventRef Task = FFunctionGraphTask::CreateAndDispatchWhenReady([&Result, &Func]()
+		{
+			const uint32 StartCycles = FPlatformTime::Cycles();
+			Result.Run(Func);
+			ParallelMovement::RecordGameThreadCallback(FPlatformTime::Cycles() - StartCycles);
+		},
+		TStatId(), nullptr, ENamedThreads::GameThread_Local);
+	FTaskGraphInterface::Get().WaitUntilTaskCompletes(Task);
+	return Result.Get();
+}
+
+/** Game-thread-only work recorded by a parallel movement worker, replayed once the parallel phase is done. */
+struct FDeferredMovementCommand
+{
+	/** Index of the component that issued the command; replay happens in component order. */
+	int32 ComponentIndex;
+	TFunction<void()> Execute;
+};
+
+typedef TArray<FDeferredMovementCommand> FMovementCommandBuffer;
+
+/**
+ * Work-stealing scheduler over index ranges. [0, Num) is split into batches of BatchSize; each worker
+ * starts out owning a contiguous run of batches, pops them from the front, and once it runs dry steals
+ * batches from the back of the other workers' runs.
+ */
+class FMovementWorkStealingScheduler
+{
+public:
+	/**
+	 * Runs Func(WorkerIndex, Begin, End) over all batches and blocks until they're done. When called from
+	 * the game thread, it services RunOnGameThread() requests from the workers while waiting.
+	 */
+	template<typename FuncType>
+	static void Run(int32 Num, int32 BatchSize, int32 NumWorkers, const FuncType& Func)
+	{
+		check(BatchSize > 0);
+		const int32 NumBatches = FMath::DivideAndRoundUp(Num, BatchSize);
+		NumWorkers = FMath::Min(NumWorkers, NumBatches);
+		if (NumWorkers <= 0)
+		{
+			return;
+		}
+
+		TArray<FWorkerRange, TAlignedHeapAllocator<PLATFORM_CACHE_LINE_SIZE>> Ranges;
+		Ranges.SetNum(NumWorkers);
+		for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; ++WorkerIndex)
+		{
+			Ranges[WorkerIndex].Range = Pack(
+				(int64)NumBatches * WorkerIndex / NumWorkers,
+				(int64)NumBatches * (WorkerIndex + 1) / NumWorkers);
+		}
+
+		FGraphEventArray Events;
+		Events.Reserve(NumWorkers);
+		for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; ++WorkerIndex)
+		{
+			Events.Add(FFunctionGraphTask::CreateAndDispatchWhenReady(
+				[&Ranges, &Func, WorkerIndex, NumWorkers, BatchSize, Num]()
+				{
+					int32 Batch;
+					for (;;)
+					{
+						bool bGotBatch = Ranges[WorkerIndex].PopFront(Batch);
+						for (int32 Offset = 1; !bGotBatch && Offset < NumWorkers; ++Offset)
+						{
+							bGotBatch = Ranges[(WorkerIndex + Offset) % NumWorkers].StealBack(Batch);
+						}
+						if (!bGotBatch)
+						{
+							break;
+						}
+						Func(WorkerIndex, Batch * BatchSize, FMath::Min((Batch + 1) * BatchSize, Num));
+					}
+				},
+				TStatId(), nullptr, ENamedThreads::AnyThread));
+		}
+
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(Events, IsInGameThread() ? ENamedThreads::GameThread_Local : ENamedThreads::AnyThread);
+	}
+
+private:
+	/**
+	 * Remaining [Front, Back) batch run of one worker, packed into one word so both ends can be claimed with a single CAS.
+	 * Aligned, and allocated aligned, so that the ranges of different workers are on separate cache lines.
+	 */
+	struct MS_ALIGN(PLATFORM_CACHE_LINE_SIZE) FWorkerRange
+	{
+		volatile int64 Range;
+
+		bool PopFront(int32& OutBatch)
+		{
+			for (;;)
+			{
+				const int64 Old = FPlatformAtomics::AtomicRead(&Range);
+				const int32 Front = GetFront(Old), Back = GetBack(Old);
+				if (Front >= Back)
+				{
+					return false;
+				}
+				if (FPlatformAtomics::InterlockedCompareExchange(&Range, Pack(Front + 1, Back), Old) == Old)
+				{
+					OutBatch = Front;
+					return true;
+				}
+			}
+		}
+
+		bool StealBack(int32& OutBatch)
+		{
+			for (;;)
+			{
+				const int64 Old = FPlatformAtomics::AtomicRead(&Range);
+				const int32 Front = GetFront(Old), Back = GetBack(Old);
+				if (Front >= Back)
+				{
+					return false;
+				}
+				if (FPlatformAtomics::InterlockedCompareExchange(&Range, Pack(Front, Back - 1), Old) == Old)
+				{
+					OutBatch = Back - 1;
+					return true;
+				}
+			}
+		}
+	} GCC_ALIGN(PLATFORM_CACHE_LINE_SIZE);
+
+	static int64 Pack(int64 Front, int64 Back) { return (Front << 32) | (uint32)Back; }
+	static int32 GetFront(int64 Range) { return (int32)(Range >> 32); }
+	static int32 GetBack(int64 Range) { return (int32)(uint32)Range; }
+};
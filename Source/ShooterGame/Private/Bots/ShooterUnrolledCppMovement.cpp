@@ -1,8 +1,46 @@
 #include "ShooterGame.h"
 #include "Bots/ShooterUnrolledCppMovement.h"
+#include "ISPC/ISPCInstrument.h"
+#include "ISPC/ISPCCycleCounters.h"
+#include "ISPC/ISPCKernelTargets.h"
 
 #include "ShooterUnrolledCppMovement_Boilerplate.inl"
 
+FMovementEventQueue* FMovementEventQueue::Active = nullptr;
+FWalkableSlopeTable* FWalkableSlopeTable::Active = nullptr;
+uint32 UShooterUnrolledCppMovementSystem::ImmediateMovementEvents = 0;
+
+namespace ParallelMovement
+{
+	/** Set while a worker runs PerformMovement() in TickParallel(); null on the serial path. */
+	static thread_local FMovementCommandBuffer* CurrentCommandBuffer = nullptr;
+	static thread_local int32 CurrentComponentIndex = INDEX_NONE;
+
+	/**
+	 * Runs game-thread-only notifications immediately on the serial path, or records them for replay
+	 * after the parallel phase. Deferred commands see the state at replay time, not at the call site.
+	 */
+	static void DeferOrRun(TFunction<void()>&& Command)
+	{
+		if (CurrentCommandBuffer)
+		{
+			CurrentCommandBuffer->Add(FDeferredMovementCommand{ CurrentComponentIndex, MoveTemp(Command) });
+		}
+		else
+		{
+			Command();
+		}
+	}
+
+	void RecordGameThreadCallback(uint32 Cycles)
+	{
+#if STATS
+		INC_DWORD_STAT(STAT_CharacterMovementParallelGameThreadCalls);
+		FThreadStats::AddMessage(GET_STATFNAME(STAT_CharacterMovementParallelGameThread), EStatOperation::Add, (int64)Cycles, true);
+#endif
+	}
+}
+
 static bool IsWalkable(const FHitResult& Hit, const float WalkableFloorZ)
 {
 	if (!Hit.IsValidBlockingHit())
@@ -149,6 +187,8 @@ void UShooterUnrolledCppMovementSystem::SetUpdatedComponent(UShooterUnrolledCppM
 	if (Comp->UpdatedComponent != OldUpdatedComponent)
 	{
 		ClearAccumulatedForces(Comp);
+		// The new component may already be in a volume, without a change to notify.
+		UpdatePhysicsVolumeSnapshot(Comp);
 	}
 
 	if (Comp->UpdatedComponent == NULL)
@@ -193,11 +233,43 @@ void UShooterUnrolledCppMovementSystem::PerformMovement(UShooterUnrolledCppMovem
 {
 	SCOPE_CYCLE_COUNTER(STAT_CharacterMovementPerformMovement);
 
-	if (!HasValidData(Comp))
+	if (!PerformMovement_Begin(Comp, DeltaSeconds))
 	{
 		return;
 	}
 
+	FVector OldVelocity;
+	FVector OldLocation;
+
+	// Scoped updates can improve performance of multiple MoveComponent calls.
+	{
+		// TODO ISPC
+		// ISPC: Deferred updates are flushed by the scope's destructor, which must not run on a worker.
+		FScopedMovementUpdate ScopedMovementUpdate(Comp->UpdatedComponent, Comp->bEnableScopedMovementUpdates && IsInGameThread() ? EScopedUpdate::DeferredUpdates : EScopedUpdate::ImmediateUpdates);
+
+		PerformMovement_PrePhysics(Comp, DeltaSeconds, OldLocation, OldVelocity);
+
+		// change position
+		StartNewPhysics(Comp, DeltaSeconds, 0);
+
+		if (!HasValidData(Comp))
+		{
+			return;
+		}
+
+		PerformMovement_PostPhysics(Comp, DeltaSeconds, OldLocation, OldVelocity);
+	} // End scoped movement update
+
+	PerformMovement_End(Comp, DeltaSeconds, OldLocation, OldVelocity);
+}
+
+bool UShooterUnrolledCppMovementSystem::PerformMovement_Begin(UShooterUnrolledCppMovement* Comp, float DeltaSeconds)
+{
+	if (!HasValidData(Comp))
+	{
+		return false;
+	}
+
 	// no movement if we can't move, or if currently doing physical simulation on UpdatedComponent
 	if (Comp->MovementMode == MOVE_None || Comp->UpdatedComponent->Mobility != EComponentMobility::Movable || Comp->UpdatedComponent->IsSimulatingPhysics())
 	{
@@ -214,7 +286,7 @@ void UShooterUnrolledCppMovementSystem::PerformMovement(UShooterUnrolledCppMovem
 		}
 		// Clear pending physics forces
 		ClearAccumulatedForces(Comp);
-		return;
+		return false;
 	}
 
 	// Force floor update if we've moved outside of CharacterMovement since last update.
@@ -239,332 +311,1186 @@ void UShooterUnrolledCppMovementSystem::PerformMovement(UShooterUnrolledCppMovem
 #endif
 	}
 
-	FVector OldVelocity;
-	FVector OldLocation;
-
-	// Scoped updates can improve performance of multiple MoveComponent calls.
-	{
-		// TODO ISPC
-		FScopedMovementUpdate ScopedMovementUpdate(Comp->UpdatedComponent, Comp->bEnableScopedMovementUpdates ? EScopedUpdate::DeferredUpdates : EScopedUpdate::ImmediateUpdates);
+	return true;
+}
 
-		MaybeUpdateBasedMovement(Comp, DeltaSeconds);
+void UShooterUnrolledCppMovementSystem::PerformMovement_PrePhysics(UShooterUnrolledCppMovement* Comp, float DeltaSeconds, FVector& OldLocation, FVector& OldVelocity)
+{
+	MaybeUpdateBasedMovement(Comp, DeltaSeconds);
 
-		// Clean up invalid RootMotion Sources.
-		// This includes RootMotion sources that ended naturally.
-		// They might want to perform a clamp on velocity or an override, 
-		// so we want this to happen before ApplyAccumulatedForces and HandlePendingLaunch as to not clobber these.
-		const bool bHasRootMotionSources = HasRootMotionSources(Comp);
-		if (bHasRootMotionSources && !Comp->CharacterOwner->bClientUpdating && !Comp->CharacterOwner->bServerMoveIgnoreRootMotion)
-		{
+	// Clean up invalid RootMotion Sources.
+	// This includes RootMotion sources that ended naturally.
+	// They might want to perform a clamp on velocity or an override, 
+	// so we want this to happen before ApplyAccumulatedForces and HandlePendingLaunch as to not clobber these.
+	const bool bHasRootMotionSources = HasRootMotionSources(Comp);
+	if (bHasRootMotionSources && !Comp->CharacterOwner->bClientUpdating && !Comp->CharacterOwner->bServerMoveIgnoreRootMotion)
+	{
 #if 1	// TODO ISPC
-			unimplemented();
+		unimplemented();
 #else
-			SCOPE_CYCLE_COUNTER(STAT_CharacterMovementRootMotionSourceCalculate);
+		SCOPE_CYCLE_COUNTER(STAT_CharacterMovementRootMotionSourceCalculate);
 
-			const FVector VelocityBeforeCleanup = Comp->Velocity;
-			Comp->CurrentRootMotion.CleanUpInvalidRootMotion(DeltaSeconds, *Comp->CharacterOwner, *Comp);
+		const FVector VelocityBeforeCleanup = Comp->Velocity;
+		Comp->CurrentRootMotion.CleanUpInvalidRootMotion(DeltaSeconds, *Comp->CharacterOwner, *Comp);
 
 #if ROOT_MOTION_DEBUG
-			if (RootMotionSourceDebug::CVarDebugRootMotionSources.GetValueOnAnyThread() == 1)
+		if (RootMotionSourceDebug::CVarDebugRootMotionSources.GetValueOnAnyThread() == 1)
+		{
+			if (Comp->Velocity != VelocityBeforeCleanup)
 			{
-				if (Comp->Velocity != VelocityBeforeCleanup)
-				{
-					const FVector Adjustment = Comp->Velocity - VelocityBeforeCleanup;
-					FString AdjustedDebugString = FString::Printf(TEXT("PerformMovement CleanUpInvalidRootMotion Velocity(%s) VelocityBeforeCleanup(%s) Adjustment(%s)"),
-						*Comp->Velocity.ToCompactString(), *VelocityBeforeCleanup.ToCompactString(), *Adjustment.ToCompactString());
-					RootMotionSourceDebug::PrintOnScreen(*Comp->CharacterOwner, AdjustedDebugString);
-				}
+				const FVector Adjustment = Comp->Velocity - VelocityBeforeCleanup;
+				FString AdjustedDebugString = FString::Printf(TEXT("PerformMovement CleanUpInvalidRootMotion Velocity(%s) VelocityBeforeCleanup(%s) Adjustment(%s)"),
+					*Comp->Velocity.ToCompactString(), *VelocityBeforeCleanup.ToCompactString(), *Adjustment.ToCompactString());
+				RootMotionSourceDebug::PrintOnScreen(*Comp->CharacterOwner, AdjustedDebugString);
 			}
+		}
 #endif
 #endif	// TODO ISPC
-		}
+	}
 
-		OldVelocity = Comp->Velocity;
-		OldLocation = Comp->UpdatedComponent->GetComponentLocation();
+	OldVelocity = Comp->Velocity;
+	OldLocation = Comp->UpdatedComponent->GetComponentLocation();
 
-		ApplyAccumulatedForces(Comp, DeltaSeconds);
+	ApplyAccumulatedForces(Comp, DeltaSeconds);
 
-		// Update the character state before we do our movement
-		UpdateCharacterStateBeforeMovement(Comp);
+	// Update the character state before we do our movement
+	UpdateCharacterStateBeforeMovement(Comp);
 
-		if (Comp->MovementMode == MOVE_NavWalking && Comp->bWantsToLeaveNavWalking)
+	if (Comp->MovementMode == MOVE_NavWalking && Comp->bWantsToLeaveNavWalking)
+	{
+		// Game thread only: changes collision settings.
+		RunOnGameThread([&]() { Comp->TryToLeaveNavWalking(); });
+	}
+
+	// Character::LaunchCharacter() has been deferred until now.
+	HandlePendingLaunch(Comp);
+	ClearAccumulatedForces(Comp);
+
+#if ROOT_MOTION_DEBUG
+	if (RootMotionSourceDebug::CVarDebugRootMotionSources.GetValueOnAnyThread() == 1)
+	{
+		if (OldVelocity != Comp->Velocity)
 		{
-			unimplemented();	// TODO ISPC
-			Comp->TryToLeaveNavWalking();
+			const FVector Adjustment = Comp->Velocity - OldVelocity;
+			FString AdjustedDebugString = FString::Printf(TEXT("PerformMovement ApplyAccumulatedForces+HandlePendingLaunch Velocity(%s) OldVelocity(%s) Adjustment(%s)"),
+				*Comp->Velocity.ToCompactString(), *OldVelocity.ToCompactString(), *Adjustment.ToCompactString());
+			RootMotionSourceDebug::PrintOnScreen(*Comp->CharacterOwner, AdjustedDebugString);
 		}
+	}
+#endif
 
-		// Character::LaunchCharacter() has been deferred until now.
-		HandlePendingLaunch(Comp);
-		ClearAccumulatedForces(Comp);
+	// Update saved LastPreAdditiveVelocity with any external changes to character Velocity that happened due to ApplyAccumulatedForces/HandlePendingLaunch
+	if (Comp->CurrentRootMotion.HasAdditiveVelocity())
+	{
+		const FVector Adjustment = (Comp->Velocity - OldVelocity);
+		Comp->CurrentRootMotion.LastPreAdditiveVelocity += Adjustment;
 
 #if ROOT_MOTION_DEBUG
 		if (RootMotionSourceDebug::CVarDebugRootMotionSources.GetValueOnAnyThread() == 1)
 		{
-			if (OldVelocity != Comp->Velocity)
+			if (!Adjustment.IsNearlyZero())
 			{
-				const FVector Adjustment = Comp->Velocity - OldVelocity;
-				FString AdjustedDebugString = FString::Printf(TEXT("PerformMovement ApplyAccumulatedForces+HandlePendingLaunch Velocity(%s) OldVelocity(%s) Adjustment(%s)"),
-					*Comp->Velocity.ToCompactString(), *OldVelocity.ToCompactString(), *Adjustment.ToCompactString());
+				FString AdjustedDebugString = FString::Printf(TEXT("PerformMovement HasAdditiveVelocity AccumulatedForces LastPreAdditiveVelocity(%s) Adjustment(%s)"),
+					*Comp->CurrentRootMotion.LastPreAdditiveVelocity.ToCompactString(), *Adjustment.ToCompactString());
 				RootMotionSourceDebug::PrintOnScreen(*Comp->CharacterOwner, AdjustedDebugString);
 			}
 		}
 #endif
+	}
 
-		// Update saved LastPreAdditiveVelocity with any external changes to character Velocity that happened due to ApplyAccumulatedForces/HandlePendingLaunch
-		if (Comp->CurrentRootMotion.HasAdditiveVelocity())
+	// Prepare Root Motion (generate/accumulate from root motion sources to be used later)
+	if (bHasRootMotionSources && !Comp->CharacterOwner->bClientUpdating && !Comp->CharacterOwner->bServerMoveIgnoreRootMotion)
+	{
+		// Animation root motion - If using animation RootMotion, tick animations before running physics.
+		if (Comp->CharacterOwner->IsPlayingRootMotion() && Comp->CharacterOwner->GetMesh())
 		{
-			const FVector Adjustment = (Comp->Velocity - OldVelocity);
-			Comp->CurrentRootMotion.LastPreAdditiveVelocity += Adjustment;
+#if 1	// TODO ISPC
+			unimplemented();
+#else
+			Comp->TickCharacterPose(DeltaSeconds);
 
-#if ROOT_MOTION_DEBUG
-			if (RootMotionSourceDebug::CVarDebugRootMotionSources.GetValueOnAnyThread() == 1)
+			// Make sure animation didn't trigger an event that destroyed us
+			if (!HasValidData(Comp))
 			{
-				if (!Adjustment.IsNearlyZero())
-				{
-					FString AdjustedDebugString = FString::Printf(TEXT("PerformMovement HasAdditiveVelocity AccumulatedForces LastPreAdditiveVelocity(%s) Adjustment(%s)"),
-						*Comp->CurrentRootMotion.LastPreAdditiveVelocity.ToCompactString(), *Adjustment.ToCompactString());
-					RootMotionSourceDebug::PrintOnScreen(*Comp->CharacterOwner, AdjustedDebugString);
-				}
+				return;
+			}
+
+			// For local human clients, save off root motion data so it can be used by movement networking code.
+			if (Comp->CharacterOwner->IsLocallyControlled() && (Comp->CharacterOwner->Role == ROLE_AutonomousProxy) && Comp->CharacterOwner->IsPlayingNetworkedRootMotionMontage())
+			{
+				Comp->CharacterOwner->ClientRootMotionParams = Comp->RootMotionParams;
 			}
 #endif
 		}
 
-		// Prepare Root Motion (generate/accumulate from root motion sources to be used later)
-		if (bHasRootMotionSources && !Comp->CharacterOwner->bClientUpdating && !Comp->CharacterOwner->bServerMoveIgnoreRootMotion)
+		// Generates root motion to be used this frame from sources other than animation
 		{
-			// Animation root motion - If using animation RootMotion, tick animations before running physics.
-			if (Comp->CharacterOwner->IsPlayingRootMotion() && Comp->CharacterOwner->GetMesh())
-			{
+			SCOPE_CYCLE_COUNTER(STAT_CharacterMovementRootMotionSourceCalculate);
+			Comp->CurrentRootMotion.PrepareRootMotion(DeltaSeconds, *Comp->CharacterOwner, *Comp, true);
+		}
+
+		// For local human clients, save off root motion data so it can be used by movement networking code.
+		if (Comp->CharacterOwner->IsLocallyControlled() && (Comp->CharacterOwner->Role == ROLE_AutonomousProxy))
+		{
+			Comp->CharacterOwner->SavedRootMotion = Comp->CurrentRootMotion;
+		}
+	}
+
+	// Apply Root Motion to Velocity
+	if (Comp->CurrentRootMotion.HasOverrideVelocity() || HasAnimRootMotion(Comp))
+	{
 #if 1	// TODO ISPC
-				unimplemented();
+		unimplemented();
 #else
-				Comp->TickCharacterPose(DeltaSeconds);
+		// Animation root motion overrides Velocity and currently doesn't allow any other root motion sources
+		if (HasAnimRootMotion(Comp))
+		{
+			// Convert to world space (animation root motion is always local)
+			USkeletalMeshComponent * SkelMeshComp = Comp->CharacterOwner->GetMesh();
+			if (SkelMeshComp)
+			{
+				// Convert Local Space Root Motion to world space. Do it right before used by physics to make sure we use up to date transforms, as translation is relative to rotation.
+				Comp->RootMotionParams.Set(ConvertLocalRootMotionToWorld(Comp, Comp->RootMotionParams.GetRootMotionTransform()));
+			}
+
+			// Then turn root motion to velocity to be used by various physics modes.
+			if (DeltaSeconds > 0.f)
+			{
+				Comp->AnimRootMotionVelocity = Comp->CalcAnimRootMotionVelocity(Comp->RootMotionParams.GetRootMotionTransform().GetTranslation(), DeltaSeconds, Comp->Velocity);
+				Comp->Velocity = Comp->ConstrainAnimRootMotionVelocity(Comp->AnimRootMotionVelocity, Comp->Velocity);
+			}
+
+			UE_LOG(LogRootMotion, Log, TEXT("PerformMovement WorldSpaceRootMotion Translation: %s, Rotation: %s, Actor Facing: %s, Velocity: %s")
+				, *Comp->RootMotionParams.GetRootMotionTransform().GetTranslation().ToCompactString()
+				, *Comp->RootMotionParams.GetRootMotionTransform().GetRotation().Rotator().ToCompactString()
+				, *Comp->CharacterOwner->GetActorForwardVector().ToCompactString()
+				, *Comp->Velocity.ToCompactString()
+			);
+		}
+		else
+		{
+			// We don't have animation root motion so we apply other sources
+			if (DeltaSeconds > 0.f)
+			{
+				SCOPE_CYCLE_COUNTER(STAT_CharacterMovementRootMotionSourceApply);
 
-				// Make sure animation didn't trigger an event that destroyed us
-				if (!HasValidData(Comp))
+				const FVector VelocityBeforeOverride = Comp->Velocity;
+				FVector NewVelocity = Comp->Velocity;
+				Comp->CurrentRootMotion.AccumulateOverrideRootMotionVelocity(DeltaSeconds, *Comp->CharacterOwner, *Comp, NewVelocity);
+				Comp->Velocity = NewVelocity;
+
+#if ROOT_MOTION_DEBUG
+				if (RootMotionSourceDebug::CVarDebugRootMotionSources.GetValueOnAnyThread() == 1)
 				{
-					return;
+					if (VelocityBeforeOverride != Comp->Velocity)
+					{
+						FString AdjustedDebugString = FString::Printf(TEXT("PerformMovement AccumulateOverrideRootMotionVelocity Velocity(%s) VelocityBeforeOverride(%s)"),
+							*Comp->Velocity.ToCompactString(), *VelocityBeforeOverride.ToCompactString());
+						RootMotionSourceDebug::PrintOnScreen(*Comp->CharacterOwner, AdjustedDebugString);
+					}
 				}
+#endif
+			}
+		}
+#endif	// TODO ISPC
+	}
+
+#if ROOT_MOTION_DEBUG
+	if (RootMotionSourceDebug::CVarDebugRootMotionSources.GetValueOnAnyThread() == 1)
+	{
+		FString AdjustedDebugString = FString::Printf(TEXT("PerformMovement Velocity(%s) OldVelocity(%s)"),
+			*Comp->Velocity.ToCompactString(), *OldVelocity.ToCompactString());
+		RootMotionSourceDebug::PrintOnScreen(*Comp->CharacterOwner, AdjustedDebugString);
+	}
+#endif
+
+	// NaN tracking
+	checkCode(ensureMsgf(!Comp->Velocity.ContainsNaN(), TEXT("UCharacterMovementComponent::PerformMovement: Velocity contains NaN (%s)\n%s"), *GetPathNameSafe(Comp), *Comp->Velocity.ToString()));
+
+	// Clear jump input now, to allow movement events to trigger it for next update.
+	Comp->CharacterOwner->ClearJumpInput();
+}
+
+void UShooterUnrolledCppMovementSystem::PerformMovement_PostPhysics(UShooterUnrolledCppMovement* Comp, float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity)
+{
+	// Update character state based on change from movement
+	UpdateCharacterStateAfterMovement(Comp);
+
+	if ((Comp->bAllowPhysicsRotationDuringAnimRootMotion || !HasAnimRootMotion(Comp)) && !Comp->CharacterOwner->IsMatineeControlled())
+	{
+		PhysicsRotation(Comp, DeltaSeconds);
+	}
+
+	// Apply Root Motion rotation after movement is complete.
+	if (HasAnimRootMotion(Comp))
+	{
+#if 1	// TODO ISPC
+		unimplemented();
+#else
+		const FQuat OldActorRotationQuat = Comp->UpdatedComponent->GetComponentQuat();
+		const FQuat RootMotionRotationQuat = Comp->RootMotionParams.GetRootMotionTransform().GetRotation();
+		if (!RootMotionRotationQuat.IsIdentity())
+		{
+			const FQuat NewActorRotationQuat = RootMotionRotationQuat * OldActorRotationQuat;
+			Comp->MoveUpdatedComponent(FVector::ZeroVector, NewActorRotationQuat, true);
+		}
 
-				// For local human clients, save off root motion data so it can be used by movement networking code.
-				if (Comp->CharacterOwner->IsLocallyControlled() && (Comp->CharacterOwner->Role == ROLE_AutonomousProxy) && Comp->CharacterOwner->IsPlayingNetworkedRootMotionMontage())
+#if !(UE_BUILD_SHIPPING)
+		// debug
+		if (false)
+		{
+			const FRotator OldActorRotation = OldActorRotationQuat.Rotator();
+			const FVector ResultingLocation = Comp->UpdatedComponent->GetComponentLocation();
+			const FRotator ResultingRotation = Comp->UpdatedComponent->GetComponentRotation();
+
+			// Show current position
+			DrawDebugCoordinateSystem(GetWorld(), Comp->CharacterOwner->GetMesh()->GetComponentLocation() + FVector(0, 0, 1), ResultingRotation, 50.f, false);
+
+			// Show resulting delta move.
+			DrawDebugLine(GetWorld(), OldLocation, ResultingLocation, FColor::Red, true, 10.f);
+
+			// Log details.
+			UE_LOG(LogRootMotion, Warning, TEXT("PerformMovement Resulting DeltaMove Translation: %s, Rotation: %s, MovementBase: %s"),
+				*(ResultingLocation - OldLocation).ToCompactString(), *(ResultingRotation - OldActorRotation).GetNormalized().ToCompactString(), *GetNameSafe(Comp->CharacterOwner->GetMovementBase()));
+
+			const FVector RMTranslation = Comp->RootMotionParams.GetRootMotionTransform().GetTranslation();
+			const FRotator RMRotation = Comp->RootMotionParams.GetRootMotionTransform().GetRotation().Rotator();
+			UE_LOG(LogRootMotion, Warning, TEXT("PerformMovement Resulting DeltaError Translation: %s, Rotation: %s"),
+				*(ResultingLocation - OldLocation - RMTranslation).ToCompactString(), *(ResultingRotation - OldActorRotation - RMRotation).GetNormalized().ToCompactString());
+		}
+#endif // !(UE_BUILD_SHIPPING)
+
+		// Root Motion has been used, clear
+		Comp->RootMotionParams.Clear();
+#endif	// TODO ISPC
+	}
+
+	// consume path following requested velocity
+	Comp->bHasRequestedVelocity = false;
+
+#if 0	// TODO ISPC: This is an empty method, don't call at all for now.
+	Comp->OnMovementUpdated(DeltaSeconds, OldLocation, OldVelocity);
+#endif
+}
+
+void UShooterUnrolledCppMovementSystem::PerformMovement_End(UShooterUnrolledCppMovement* Comp, float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity)
+{
+	// Call external post-movement events. These happen after the scoped movement completes in case the events want to use the current state of overlaps etc.
+	CallMovementUpdateDelegate(Comp, DeltaSeconds, OldLocation, OldVelocity);
+
+	MaybeSaveBaseLocation(Comp);
+	UpdateComponentVelocity(Comp);
+
+	const bool bHasAuthority = Comp->CharacterOwner && Comp->CharacterOwner->HasAuthority();
+
+	// TODO ISPC: Uniformize UNetDriver::IsAdaptiveNetUpdateFrequencyEnabled() and foreach_active this entire if.
+	// If we move we want to avoid a long delay before replication catches up to notice this change, especially if it's throttling our rate.
+	if (bHasAuthority && UNetDriver::IsAdaptiveNetUpdateFrequencyEnabled() && Comp->UpdatedComponent)
+	{
+		const UWorld* MyWorld = GetWorld();
+		if (MyWorld)
+		{
+			UNetDriver* NetDriver = MyWorld->GetNetDriver();
+			if (NetDriver && NetDriver->IsServer())
+			{
+				FNetworkObjectInfo* NetActor = NetDriver->FindOrAddNetworkObjectInfo(Comp->CharacterOwner);
+
+				if (NetActor && MyWorld->GetTimeSeconds() <= NetActor->NextUpdateTime && NetDriver->IsNetworkActorUpdateFrequencyThrottled(*NetActor))
 				{
-					Comp->CharacterOwner->ClientRootMotionParams = Comp->RootMotionParams;
+					if (Comp->ShouldCancelAdaptiveReplication())
+					{
+						RunOnGameThread([&]() { NetDriver->CancelAdaptiveReplication(*NetActor); });
+					}
 				}
-#endif
 			}
+		}
+	}
+
+	const FVector NewLocation = Comp->UpdatedComponent ? Comp->UpdatedComponent->GetComponentLocation() : FVector::ZeroVector;
+	const FQuat NewRotation = Comp->UpdatedComponent ? Comp->UpdatedComponent->GetComponentQuat() : FQuat::Identity;
+
+	if (bHasAuthority && Comp->UpdatedComponent && !Comp->IsNetMode(NM_Client))
+	{
+		const bool bLocationChanged = (NewLocation != Comp->LastUpdateLocation);
+		const bool bRotationChanged = (NewRotation != Comp->LastUpdateRotation);
+		if (bLocationChanged || bRotationChanged)
+		{
+			const UWorld* MyWorld = GetWorld();
+			Comp->ServerLastTransformUpdateTimeStamp = MyWorld ? MyWorld->GetTimeSeconds() : 0.f;
+		}
+	}
+
+	Comp->LastUpdateLocation = NewLocation;
+	Comp->LastUpdateRotation = NewRotation;
+	Comp->LastUpdateVelocity = Comp->Velocity;
+}
 
-			// Generates root motion to be used this frame from sources other than animation
+void UShooterUnrolledCppMovementSystem::Tick(float DeltaSeconds)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	MovementEvents.ImmediateTypes = (uint32)CVarImmediateMovementEvents.GetValueOnGameThread() | ImmediateMovementEvents;
+	FMovementEventQueue::Active = &MovementEvents;
+	ON_SCOPE_EXIT
+	{
+		DeliverMovementEvents();
+		LastTickCycles = FPlatformTime::Cycles64() - StartCycles;
+	};
+
+	const bool bTickISPC = CVars::MovementImplementation && CVars::MovementImplementation->GetInt() == 2;
+	UpdateBotBroadphase(!bTickISPC && CVarBotBroadphase.GetValueOnGameThread() != 0);
+	RefreshCollisionParams();
+
+	// Volumes without their own gravity follow the world's, which can change without a volume change.
+	const float WorldGravityZ = GetWorld()->GetGravityZ();
+	if (WorldGravityZ != LastWorldGravityZ)
+	{
+		LastWorldGravityZ = WorldGravityZ;
+		for (UShooterUnrolledCppMovement* Comp : Components)
+		{
+			UpdatePhysicsVolumeSnapshot(Comp);
+		}
+	}
+	if (bTickISPC)
+	{
+		// The kernel moves everyone at full rate, so leave no mesh halfway through an LOD blend.
+		if (bMovementLODActive)
+		{
+			LODInterpolatingBots.Reset();
+			ResetMovementLOD();
+			InterpolateMovementLOD(DeltaSeconds);
+		}
+		TickISPC(DeltaSeconds);
+		return;
+	}
+
+	UpdateMovementLOD(DeltaSeconds);
+
+	const int32 BatchSize = FMath::Max(1, CVarCppMovementBatchSize.GetValueOnGameThread());
+	if (CVarCppMovementParallel.GetValueOnGameThread() != 0 && TickComponents.Num() > BatchSize && FTaskGraphInterface::Get().GetNumWorkerThreads() > 0)
+	{
+		TickParallel(DeltaSeconds);
+	}
+	else
+	{
+		const bool bBatchNavWalking = CVarCppNavWalkingBatching.GetValueOnGameThread() != 0;
+		NavWalkingBots.Reset();
+		NavWalkingDeltaSeconds.Reset();
+		for (int32 Index = 0; Index < TickComponents.Num(); ++Index)
+		{
+			UShooterUnrolledCppMovement* Comp = TickComponents[Index];
+			if (bBatchNavWalking && Comp->MovementMode == MOVE_NavWalking)
 			{
-				SCOPE_CYCLE_COUNTER(STAT_CharacterMovementRootMotionSourceCalculate);
-				Comp->CurrentRootMotion.PrepareRootMotion(DeltaSeconds, *Comp->CharacterOwner, *Comp, true);
+				NavWalkingBots.Add(Comp);
+				NavWalkingDeltaSeconds.Add(TickDeltaSeconds[Index]);
+				continue;
 			}
+			PerformMovement(Comp, TickDeltaSeconds[Index]);
+		}
 
-			// For local human clients, save off root motion data so it can be used by movement networking code.
-			if (Comp->CharacterOwner->IsLocallyControlled() && (Comp->CharacterOwner->Role == ROLE_AutonomousProxy))
+		if (NavWalkingBots.Num() > 0)
+		{
+			TickNavWalkingBatched();
+		}
+	}
+
+	InterpolateMovementLOD(DeltaSeconds);
+}
+
+void UShooterUnrolledCppMovementSystem::UpdateMovementLOD(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CharacterMovementLODUpdate);
+
+	TickComponents.Reset();
+	TickDeltaSeconds.Reset();
+	LODInterpolatingBots.Reset();
+
+	LODViewLocations.Reset();
+	if (CVarMovementLOD.GetValueOnGameThread() != 0)
+	{
+		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			if (const APlayerController* PlayerController = It->Get())
 			{
-				Comp->CharacterOwner->SavedRootMotion = Comp->CurrentRootMotion;
+				FVector ViewLocation;
+				FRotator ViewRotation;
+				PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+				LODViewLocations.Add(ViewLocation);
 			}
 		}
+	}
 
-		// Apply Root Motion to Velocity
-		if (Comp->CurrentRootMotion.HasOverrideVelocity() || HasAnimRootMotion(Comp))
+	const bool bWasActive = bMovementLODActive;
+	bMovementLODActive = LODViewLocations.Num() > 0;
+	if (!bMovementLODActive)
+	{
+		// Everyone moves at full rate. Right after LOD was turned off (or the last player left), hand out the time
+		// reduced-rate bots have accumulated and snap their meshes back.
+		TickComponents.Append(Components);
+		TickDeltaSeconds.Init(DeltaSeconds, Components.Num());
+		if (bWasActive)
 		{
-#if 1	// TODO ISPC
-			unimplemented();
-#else
-			// Animation root motion overrides Velocity and currently doesn't allow any other root motion sources
-			if (HasAnimRootMotion(Comp))
+			for (int32 Index = 0; Index < Components.Num(); ++Index)
 			{
-				// Convert to world space (animation root motion is always local)
-				USkeletalMeshComponent * SkelMeshComp = Comp->CharacterOwner->GetMesh();
-				if (SkelMeshComp)
-				{
-					// Convert Local Space Root Motion to world space. Do it right before used by physics to make sure we use up to date transforms, as translation is relative to rotation.
-					Comp->RootMotionParams.Set(ConvertLocalRootMotionToWorld(Comp, Comp->RootMotionParams.GetRootMotionTransform()));
-				}
+				TickDeltaSeconds[Index] += Components[Index]->MovementLOD.AccumulatedTime;
+			}
+			ResetMovementLOD();
+		}
+		return;
+	}
 
-				// Then turn root motion to velocity to be used by various physics modes.
-				if (DeltaSeconds > 0.f)
-				{
-					Comp->AnimRootMotionVelocity = Comp->CalcAnimRootMotionVelocity(Comp->RootMotionParams.GetRootMotionTransform().GetTranslation(), DeltaSeconds, Comp->Velocity);
-					Comp->Velocity = Comp->ConstrainAnimRootMotionVelocity(Comp->AnimRootMotionVelocity, Comp->Velocity);
-				}
+	// Squared distances beyond which bots tick every 2nd, 4th and 8th frame; levels set to 0 are skipped.
+	const float LODDistances[] =
+	{
+		CVarMovementLODDistance2.GetValueOnGameThread(),
+		CVarMovementLODDistance4.GetValueOnGameThread(),
+		CVarMovementLODDistance8.GetValueOnGameThread(),
+	};
+	float LODDistancesSq[ARRAY_COUNT(LODDistances)];
+	for (int32 Level = 0; Level < ARRAY_COUNT(LODDistances); ++Level)
+	{
+		LODDistancesSq[Level] = LODDistances[Level] > 0.f ? FMath::Square(LODDistances[Level]) : MAX_flt;
+	}
 
-				UE_LOG(LogRootMotion, Log, TEXT("PerformMovement WorldSpaceRootMotion Translation: %s, Rotation: %s, Actor Facing: %s, Velocity: %s")
-					, *Comp->RootMotionParams.GetRootMotionTransform().GetTranslation().ToCompactString()
-					, *Comp->RootMotionParams.GetRootMotionTransform().GetRotation().Rotator().ToCompactString()
-					, *Comp->CharacterOwner->GetActorForwardVector().ToCompactString()
-					, *Comp->Velocity.ToCompactString()
-				);
+	const bool bInterpolate = CVarMovementLODInterpolation.GetValueOnGameThread() != 0 && GetWorld()->GetNetMode() != NM_DedicatedServer;
+	++LODFrameCounter;
+	int32 NumSkipped = 0;
+	for (UShooterUnrolledCppMovement* Comp : Components)
+	{
+		FMovementLODState& LOD = Comp->MovementLOD;
+		const FVector Location = Comp->UpdatedComponent ? Comp->UpdatedComponent->GetComponentLocation() : FVector::ZeroVector;
+
+		float MinDistanceSq = MAX_flt;
+		for (const FVector& ViewLocation : LODViewLocations)
+		{
+			MinDistanceSq = FMath::Min(MinDistanceSq, FVector::DistSquared(ViewLocation, Location));
+		}
+		uint8 RateShift = 0;
+		for (int32 Level = 0; Level < ARRAY_COUNT(LODDistancesSq); ++Level)
+		{
+			if (MinDistanceSq >= LODDistancesSq[Level])
+			{
+				RateShift = Level + 1;
 			}
-			else
+		}
+		LOD.RateShift = RateShift;
+		LOD.AccumulatedTime += DeltaSeconds;
+
+		// Stagger bots of the same rate across frames by their index, so that the per-frame cost stays flat.
+		const uint32 RateMask = (1u << RateShift) - 1;
+		if (((LODFrameCounter + (uint32)Comp->SystemIndex) & RateMask) != 0)
+		{
+			++NumSkipped;
+			if (LOD.InterpRemaining > 0.f)
 			{
-				// We don't have animation root motion so we apply other sources
-				if (DeltaSeconds > 0.f)
-				{
-					SCOPE_CYCLE_COUNTER(STAT_CharacterMovementRootMotionSourceApply);
+				LODInterpolatingBots.Add(Comp);
+			}
+			continue;
+		}
 
-					const FVector VelocityBeforeOverride = Comp->Velocity;
-					FVector NewVelocity = Comp->Velocity;
-					Comp->CurrentRootMotion.AccumulateOverrideRootMotionVelocity(DeltaSeconds, *Comp->CharacterOwner, *Comp, NewVelocity);
-					Comp->Velocity = NewVelocity;
+		TickComponents.Add(Comp);
+		TickDeltaSeconds.Add(LOD.AccumulatedTime);
+		LOD.AccumulatedTime = 0.f;
 
-#if ROOT_MOTION_DEBUG
-					if (RootMotionSourceDebug::CVarDebugRootMotionSources.GetValueOnAnyThread() == 1)
-					{
-						if (VelocityBeforeOverride != Comp->Velocity)
-						{
-							FString AdjustedDebugString = FString::Printf(TEXT("PerformMovement AccumulateOverrideRootMotionVelocity Velocity(%s) VelocityBeforeOverride(%s)"),
-								*Comp->Velocity.ToCompactString(), *VelocityBeforeOverride.ToCompactString());
-							RootMotionSourceDebug::PrintOnScreen(*Comp->CharacterOwner, AdjustedDebugString);
-						}
-					}
-#endif
-				}
+		LOD.bInterpolateTick = bInterpolate && RateShift > 0 && Comp->UpdatedComponent;
+		if (LOD.bInterpolateTick)
+		{
+			LOD.PrevLocation = Location;
+			LOD.PrevRotation = Comp->UpdatedComponent->GetComponentQuat();
+		}
+		if (LOD.bInterpolateTick || LOD.InterpRemaining > 0.f)
+		{
+			LODInterpolatingBots.Add(Comp);
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_CharacterMovementLODSkipped, NumSkipped);
+}
+
+void UShooterUnrolledCppMovementSystem::ResetMovementLOD()
+{
+	bMovementLODActive = false;
+	for (UShooterUnrolledCppMovement* Comp : Components)
+	{
+		FMovementLODState& LOD = Comp->MovementLOD;
+		LOD.AccumulatedTime = 0.f;
+		LOD.RateShift = 0;
+		LOD.bInterpolateTick = false;
+		if (LOD.InterpRemaining > 0.f)
+		{
+			LOD.InterpRemaining = 0.f;
+			LODInterpolatingBots.Add(Comp);
+		}
+	}
+}
+
+void UShooterUnrolledCppMovementSystem::InterpolateMovementLOD(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CharacterMovementLODInterpolation);
+
+	for (UShooterUnrolledCppMovement* Comp : LODInterpolatingBots)
+	{
+		FMovementLODState& LOD = Comp->MovementLOD;
+		ACharacter* CharacterOwner = Comp->CharacterOwner;
+		USkeletalMeshComponent* Mesh = CharacterOwner ? CharacterOwner->GetMesh() : nullptr;
+		if (Mesh == nullptr || Comp->UpdatedComponent == nullptr)
+		{
+			LOD = FMovementLODState();
+			continue;
+		}
+
+		const FQuat CapsuleRotation = Comp->UpdatedComponent->GetComponentQuat();
+		if (LOD.bInterpolateTick)
+		{
+			// Leave the mesh where it was rendered and blend it into place until the bot's next tick.
+			LOD.bInterpolateTick = false;
+			LOD.MeshOffset += LOD.PrevLocation - Comp->UpdatedComponent->GetComponentLocation();
+			LOD.MeshRotationOffset = CapsuleRotation.Inverse() * LOD.PrevRotation * LOD.MeshRotationOffset;
+			LOD.InterpRemaining = (1 << LOD.RateShift) * DeltaSeconds;
+			if (LOD.MeshOffset.SizeSquared() > FMath::Square(Comp->NetworkNoSmoothUpdateDistance))
+			{
+				// Teleported, don't drag the mesh across the map.
+				LOD.MeshOffset = FVector::ZeroVector;
+				LOD.MeshRotationOffset = FQuat::Identity;
+				LOD.InterpRemaining = 0.f;
 			}
-#endif	// TODO ISPC
 		}
 
-#if ROOT_MOTION_DEBUG
-		if (RootMotionSourceDebug::CVarDebugRootMotionSources.GetValueOnAnyThread() == 1)
+		const float Alpha = LOD.InterpRemaining > DeltaSeconds ? DeltaSeconds / LOD.InterpRemaining : 1.f;
+		LOD.InterpRemaining = FMath::Max(0.f, LOD.InterpRemaining - DeltaSeconds);
+		LOD.MeshOffset *= 1.f - Alpha;
+		LOD.MeshRotationOffset = FQuat::Slerp(LOD.MeshRotationOffset, FQuat::Identity, Alpha);
+		Mesh->SetRelativeLocationAndRotation(
+			CharacterOwner->GetBaseTranslationOffset() + CapsuleRotation.UnrotateVector(LOD.MeshOffset),
+			LOD.MeshRotationOffset * CharacterOwner->GetBaseRotationOffset());
+	}
+}
+
+void UShooterUnrolledCppMovementSystem::UpdateBotBroadphase(bool bEnable)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CharBotBroadphaseBuild);
+
+	const int32 ChannelNumber = FMath::Clamp(CVarBotBroadphaseChannel.GetValueOnGameThread(), 1, 18);
+	const ECollisionChannel Channel = bEnable ? (ECollisionChannel)(ECC_GameTraceChannel1 + ChannelNumber - 1) : ECC_MAX;
+	if (Channel != BotBroadphaseChannel && BotBroadphaseChannel != ECC_MAX)
+	{
+		// Turned off or moved to another channel, put all capsules back first.
+		for (UShooterUnrolledCppMovement* Comp : Components)
 		{
-			FString AdjustedDebugString = FString::Printf(TEXT("PerformMovement Velocity(%s) OldVelocity(%s)"),
-				*Comp->Velocity.ToCompactString(), *OldVelocity.ToCompactString());
-			RootMotionSourceDebug::PrintOnScreen(*Comp->CharacterOwner, AdjustedDebugString);
+			SetBotBroadphaseCollision(Comp, false);
+		}
+	}
+	BotBroadphaseChannel = Channel;
+
+	if (!bEnable)
+	{
+		BotBroadphase.Empty();
+		return;
+	}
+
+	// Rebuilt from scratch once per tick, then kept up to date by MoveUpdatedComponent().
+	BotCapsules.SetNum(Components.Num());
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		UShooterUnrolledCppMovement* Comp = Components[Index];
+		SetBotBroadphaseCollision(Comp, true);
+
+		FBotCapsule& Capsule = BotCapsules[Index];
+		Capsule.Location = Comp->UpdatedComponent ? Comp->UpdatedComponent->GetComponentLocation() : FVector::ZeroVector;
+		Capsule.Radius = 0.f;
+		Capsule.HalfHeight = 0.f;
+		if (Comp->CharacterOwner && Comp->CharacterOwner->GetCapsuleComponent())
+		{
+			Comp->CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleSize(Capsule.Radius, Capsule.HalfHeight);
+		}
+	}
+	BotBroadphase.Build(BotCapsules, CVarBotBroadphaseCellSize.GetValueOnGameThread());
+}
+
+void UShooterUnrolledCppMovementSystem::SetBotBroadphaseCollision(UShooterUnrolledCppMovement* Comp, bool bEnable)
+{
+	FBotBroadphaseState& State = Comp->BotBroadphase;
+	if (!bEnable)
+	{
+		if (UPrimitiveComponent* Primitive = State.Primitive.Get())
+		{
+			Primitive->SetCollisionResponseToChannel(State.Channel, State.SavedBotChannelResponse);
+			Primitive->SetCollisionObjectType(State.SavedObjectType);
+		}
+		State.Primitive = nullptr;
+		return;
+	}
+
+	UPrimitiveComponent* Primitive = Comp->UpdatedPrimitive;
+	if (State.Primitive.Get() == Primitive || Primitive == nullptr)
+	{
+		return;
+	}
+	SetBotBroadphaseCollision(Comp, false);
+
+	// Bots ignore each other through the bot channel; everything else keeps its (default) response to it.
+	State.Primitive = Primitive;
+	State.Channel = BotBroadphaseChannel;
+	State.SavedObjectType = Primitive->GetCollisionObjectType();
+	State.SavedBotChannelResponse = Primitive->GetCollisionResponseToChannel(BotBroadphaseChannel);
+	Primitive->SetCollisionObjectType(BotBroadphaseChannel);
+	Primitive->SetCollisionResponseToChannel(BotBroadphaseChannel, ECR_Ignore);
+}
+
+/** Hash of everything UPrimitiveComponent::InitSweepCollisionParams() reads. */
+static uint32 HashSweepCollisionSettings(const UPrimitiveComponent* Primitive)
+{
+	const FCollisionResponseContainer& Responses = Primitive->GetCollisionResponseToChannels();
+	uint32 Hash = FCrc::MemCrc32(&Responses, sizeof(Responses));
+	for (const AActor* Actor : Primitive->GetMoveIgnoreActors())
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Actor));
+	}
+	for (const UPrimitiveComponent* Component : Primitive->GetMoveIgnoreComponents())
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Component));
+	}
+	const uint32 Flags = (Primitive->bCheckAsyncSceneOnMove ? 1 : 0) | (Primitive->bTraceComplexOnMove ? 2 : 0) | (Primitive->bReturnMaterialOnMove ? 4 : 0);
+	return HashCombine(Hash, (Flags << 8) | (uint32)Primitive->GetMoveIgnoreMask());
+}
+
+void UShooterUnrolledCppMovementSystem::RefreshCollisionParams()
+{
+	SCOPE_CYCLE_COUNTER(STAT_CharCollisionParamsRefresh);
+
+	// The engine doesn't version collision settings, so changes are detected by hashing them once per tick.
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		UpdateCollisionParams(Components[Index], CollisionParamsPool[Index], true);
+	}
+}
+
+void UShooterUnrolledCppMovementSystem::UpdateCollisionParams(UShooterUnrolledCppMovement* Comp, FPooledCollisionParams& Entry, bool bCheckSettings) const
+{
+	const UPrimitiveComponent* Primitive = Comp->UpdatedPrimitive;
+	const bool bSameOwner = Entry.bBuilt && Entry.Primitive == Primitive && Entry.IgnoreActor == Comp->CharacterOwner;
+	if (bSameOwner && !bCheckSettings)
+	{
+		return;
+	}
+	const uint32 SettingsHash = Primitive ? HashSweepCollisionSettings(Primitive) : 0;
+	if (bSameOwner && SettingsHash == Entry.SettingsHash)
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_CharCollisionParamsRebuilds);
+	Entry.QueryParams[BQS_ComputeFloorDist] = FCollisionQueryParams(SCENE_QUERY_STAT(ComputeFloorDist), false, Comp->CharacterOwner);
+	Entry.QueryParams[BQS_CheckLedgeDirection] = FCollisionQueryParams(SCENE_QUERY_STAT(CheckLedgeDirection), false, Comp->CharacterOwner);
+	Entry.QueryParams[BQS_CrouchTrace] = FCollisionQueryParams(SCENE_QUERY_STAT(CrouchTrace), false, Comp->CharacterOwner);
+	Entry.QueryParams[BQS_MovementOverlapTest] = FCollisionQueryParams(SCENE_QUERY_STAT(MovementOverlapTest), false, Comp->CharacterOwner);
+	Entry.ResponseParams = FCollisionResponseParams();
+	for (FCollisionQueryParams& QueryParams : Entry.QueryParams)
+	{
+		InitCollisionParams(Comp, QueryParams, Entry.ResponseParams);
+	}
+	// Like UCharacterMovementComponent::ComputeFloorDist(), which retags its sweep params for the line trace.
+	Entry.QueryParams[BQS_FloorLineTrace] = Entry.QueryParams[BQS_ComputeFloorDist];
+	Entry.QueryParams[BQS_FloorLineTrace].TraceTag = SCENE_QUERY_STAT_NAME_ONLY(FloorLineTrace);
+	Entry.Primitive = Primitive;
+	Entry.IgnoreActor = Comp->CharacterOwner;
+	Entry.SettingsHash = SettingsHash;
+	Entry.bBuilt = true;
+}
+
+const FPooledCollisionParams& UShooterUnrolledCppMovementSystem::GetCollisionParams(UShooterUnrolledCppMovement* Comp) const
+{
+	// Catches bots registered or re-parented since RefreshCollisionParams().
+	FPooledCollisionParams& Entry = CollisionParamsPool[Comp->SystemIndex];
+	UpdateCollisionParams(Comp, Entry, false);
+	return Entry;
+}
+
+void UShooterUnrolledCppMovementSystem::DeliverMovementEvents()
+{
+	SCOPE_CYCLE_COUNTER(STAT_CharacterMovementDeliverEvents);
+
+	// Game code run by the events may move bots again; anything that triggers is delivered immediately.
+	FMovementEventQueue::Active = nullptr;
+	const int32 NumEvents = MovementEvents.Drain([this](const FMovementEvent& Event) { DeliverMovementEvent(Event); });
+	INC_DWORD_STAT_BY(STAT_CharacterMovementQueuedEvents, NumEvents);
+}
+
+void UShooterUnrolledCppMovementSystem::DeliverMovementEvent(const FMovementEvent& Event)
+{
+	// An earlier event may have destroyed the character.
+	if (!IsValid(Event.CharacterOwner))
+	{
+		return;
+	}
+
+	switch (Event.Type)
+	{
+	case EMovementEventType::MovementUpdated:
+		Event.CharacterOwner->OnCharacterMovementUpdated.Broadcast(Event.Time, Event.Location, Event.Velocity);
+		break;
+	case EMovementEventType::Landed:
+		Event.CharacterOwner->Landed(Event.Hit);
+		break;
+	case EMovementEventType::JumpApex:
+		Event.CharacterOwner->NotifyJumpApex();
+		break;
+	case EMovementEventType::Impact:
+		DeliverImpact(Event.Comp, Event.Hit, Event.Time, Event.Delta, Event.Acceleration, Event.Velocity);
+		break;
+	case EMovementEventType::StuckInGeometry:
+		LogStuckInGeometry(Event.Comp, Event.bHasHit ? &Event.Hit : nullptr, Event.Velocity, Event.Count);
+		break;
+	case EMovementEventType::MovementModeChanged:
+		Event.CharacterOwner->OnMovementModeChanged((EMovementMode)Event.PreviousMovementMode, Event.PreviousCustomMode);
+		break;
+	default:
+		checkNoEntry();
+	}
+}
+
+void UShooterUnrolledCppMovementSystem::TickNavWalkingBatched()
+{
+	SCOPE_CYCLE_COUNTER(STAT_CharacterMovementPerformMovement);
+
+	// Same as PerformMovement() without the scoped movement update, which can't stay open across passes. NavWalking
+	// makes a single move per step, so there would be little for it to defer anyway.
+	NavWalkingMoves.Reset();
+	NavWalkingMoves.SetNum(NavWalkingBots.Num());
+
+	// Everything up to the navmesh projection, collecting the destinations. Bots that don't get that far (or reuse
+	// CachedNavLocation) don't request a projection.
+	for (int32 Index = 0; Index < NavWalkingBots.Num(); ++Index)
+	{
+		UShooterUnrolledCppMovement* Comp = NavWalkingBots[Index];
+		FNavWalkingMove& Move = NavWalkingMoves[Index];
+		const float DeltaSeconds = NavWalkingDeltaSeconds[Index];
+		if (!PerformMovement_Begin(Comp, DeltaSeconds))
+		{
+			continue;
+		}
+
+		Move.bPerformMovement = true;
+		PerformMovement_PrePhysics(Comp, DeltaSeconds, Move.PerformOldLocation, Move.PerformOldVelocity);
+
+		// The mode may have changed before physics, e.g. when leaving NavWalking.
+		if (Comp->MovementMode != MOVE_NavWalking)
+		{
+			StartNewPhysics(Comp, DeltaSeconds, 0);
+			continue;
+		}
+
+		if (!BeginNewPhysics(Comp, DeltaSeconds, 0, Move.bSavedMovementInProgress))
+		{
+			continue;
 		}
+
+		SCOPE_CYCLE_COUNTER(STAT_CharPhysNavWalking);
+		Move.bInPhysics = true;
+		Move.bPending = BeginPhysNavWalking(Comp, DeltaSeconds, 0, Move);
+	}
+
+	FindNavFloors(NavWalkingMoves);
+
+	// Apply the projections and finish the movement update.
+	for (int32 Index = 0; Index < NavWalkingBots.Num(); ++Index)
+	{
+		UShooterUnrolledCppMovement* Comp = NavWalkingBots[Index];
+		FNavWalkingMove& Move = NavWalkingMoves[Index];
+		const float DeltaSeconds = NavWalkingDeltaSeconds[Index];
+		if (!Move.bPerformMovement)
+		{
+			continue;
+		}
+
+		if (Move.bInPhysics)
+		{
+			if (Move.bPending)
+			{
+				SCOPE_CYCLE_COUNTER(STAT_CharPhysNavWalking);
+				FinishPhysNavWalking(Move);
+			}
+			EndNewPhysics(Comp, Move.bSavedMovementInProgress);
+		}
+
+		if (!HasValidData(Comp))
+		{
+			continue;
+		}
+
+		PerformMovement_PostPhysics(Comp, DeltaSeconds, Move.PerformOldLocation, Move.PerformOldVelocity);
+		PerformMovement_End(Comp, DeltaSeconds, Move.PerformOldLocation, Move.PerformOldVelocity);
+	}
+}
+
+void UShooterUnrolledCppMovementSystem::TickParallel(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CharacterMovementParallelTick);
+
+	const int32 BatchSize = FMath::Max(1, CVarCppMovementBatchSize.GetValueOnGameThread());
+	const int32 NumWorkers = FTaskGraphInterface::Get().GetNumWorkerThreads();
+
+	CommandBuffers.SetNum(NumWorkers);
+	for (FMovementCommandBuffer& Buffer : CommandBuffers)
+	{
+		Buffer.Reset();
+	}
+
+	FMovementWorkStealingScheduler::Run(TickComponents.Num(), BatchSize, NumWorkers,
+		[this](int32 WorkerIndex, int32 Begin, int32 End)
+		{
+			TGuardValue<FMovementCommandBuffer*> BufferGuard(ParallelMovement::CurrentCommandBuffer, &CommandBuffers[WorkerIndex]);
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				ParallelMovement::CurrentComponentIndex = Index;
+				PerformMovement(TickComponents[Index], TickDeltaSeconds[Index]);
+			}
+			ParallelMovement::CurrentComponentIndex = INDEX_NONE;
+		});
+
+	// Replay deferred notifications in component order, so that the outcome does not depend on scheduling.
+	SCOPE_CYCLE_COUNTER(STAT_CharacterMovementParallelReplay);
+	FMovementCommandBuffer Merged;
+	for (FMovementCommandBuffer& Buffer : CommandBuffers)
+	{
+		Merged.Append(MoveTemp(Buffer));
+		Buffer.Reset();
+	}
+	Merged.StableSort([](const FDeferredMovementCommand& A, const FDeferredMovementCommand& B) { return A.ComponentIndex < B.ComponentIndex; });
+	for (FDeferredMovementCommand& Command : Merged)
+	{
+		Command.Execute();
+	}
+}
+
+void UShooterUnrolledCppMovementSystem::TickISPC(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CharacterMovementISPCTick);
+
+	check(ISPCStore.Num() == Components.Num());
+	if (Components.Num() == 0)
+	{
+		return;
+	}
+
+	GatherISPCStore();
+	INC_DWORD_STAT_BY(STAT_CharacterMovementISPCVectorBots, Components.Num() - ISPCScalarBots.Num());
+	INC_DWORD_STAT_BY(STAT_CharacterMovementISPCScalarBots, ISPCScalarBots.Num());
+
+	if (ISPCScalarBots.Num() < Components.Num())
+	{
+		// Only the kernel's floor code looks walkable slopes up. Until a mode that runs it is live, the table stays
+		// empty and costs nothing.
+		static const uint32 FloorMovementModes = (1u << MOVE_Walking) | (1u << MOVE_NavWalking) | (1u << MOVE_Falling);
+		static const bool bKernelFindsFloors = (ispc::GetKernelMovementModes() & FloorMovementModes) != 0;
+		if (bKernelFindsFloors)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_CharWalkableSlopeFlush);
+			WalkableSlopes.Flush();
+			SET_DWORD_STAT(STAT_CharWalkableSlopeEntries, WalkableSlopes.GetNum());
+		}
+
+		SCOPE_CYCLE_COUNTER(STAT_CharacterMovementISPCKernel);
+		FWalkableSlopeTable::Active = bKernelFindsFloors ? &WalkableSlopes : nullptr;
+		ON_SCOPE_EXIT { FWalkableSlopeTable::Active = nullptr; };
+		FISPCMovementArrays Arrays = ISPCStore.MakeArrays(UNetDriver::IsAdaptiveNetUpdateFrequencyEnabled(), GetWorld()->GetTimeSeconds(), WalkableSlopes);
+		const int32 ChunkSize = CVarISPCMovementChunkSize.GetValueOnGameThread();
+		if (CVarISPCMovementBucketing.GetValueOnGameThread() != 0)
+		{
+			TickISPCBucketed(DeltaSeconds, Arrays, ChunkSize);
+		}
+		else if (ChunkSize > 0 && Components.Num() > ChunkSize)
+		{
+			ISPCKernelTargets::Get().TickParallel(DeltaSeconds, reinterpret_cast<ispc::FISPCMovementArrays*>(&Arrays), Components.Num(), ChunkSize);
+		}
+		else
+		{
+			ISPCKernelTargets::Get().Tick(DeltaSeconds, reinterpret_cast<ispc::FISPCMovementArrays*>(&Arrays), Components.Num());
+		}
+	}
+
+	ScatterISPCStore();
+
+	// After the scatter, so that it can't overwrite what these bots do.
+	if (ISPCScalarBots.Num() > 0)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_CharacterMovementISPCScalarFallback);
+		for (UShooterUnrolledCppMovement* Comp : ISPCScalarBots)
+		{
+			PerformMovement(Comp, DeltaSeconds);
+		}
+	}
+
+#if STATS
+	// Add the kernel's own timings to the stats the C++ implementation reports.
+	uint64 KernelCycles[ISPCCycleStat_Count];
+	ISPCCycleCounters::Flush(KernelCycles);
+#define ISPC_CYCLE_STAT_FLUSH(Stat)	\
+	if (KernelCycles[ISPCCycleStat_##Stat] > 0)	\
+	{	\
+		FThreadStats::AddMessage(GET_STATFNAME(Stat), EStatOperation::Add, (int64)KernelCycles[ISPCCycleStat_##Stat], true);	\
+	}
+	ISPC_CYCLE_STATS(ISPC_CYCLE_STAT_FLUSH)
+#undef ISPC_CYCLE_STAT_FLUSH
+#endif
+
+#if ISPC_INSTRUMENTATION
+	ISPCInstrumentation::PublishFrameStats();
 #endif
+}
 
-		// NaN tracking
-		checkCode(ensureMsgf(!Comp->Velocity.ContainsNaN(), TEXT("UCharacterMovementComponent::PerformMovement: Velocity contains NaN (%s)\n%s"), *GetPathNameSafe(Comp), *Comp->Velocity.ToString()));
+void UShooterUnrolledCppMovementSystem::TickISPCBucketed(float DeltaSeconds, FISPCMovementArrays& Arrays, int32 ChunkSize)
+{
+	// Mode changes normally settle within a pass or two; whatever is still re-queued after this many passes
+	// finishes its physics step unbucketed.
+	static const int32 MaxBucketingPasses = 4;
 
-		// Clear jump input now, to allow movement events to trigger it for next update.
-		Comp->CharacterOwner->ClearJumpInput();
+	const int32 Num = Components.Num();
+	const FISPCKernelTarget& Kernel = ISPCKernelTargets::Get();
+	ispc::FISPCMovementArrays* KernelArrays = reinterpret_cast<ispc::FISPCMovementArrays*>(&Arrays);
 
-		// change position
-		StartNewPhysics(Comp, DeltaSeconds, 0);
+	ISPCPhysicsQueue.SetNum(Num);
+	FISPCPhysicsQueue Queue = ISPCPhysicsQueue.MakeQueue();
+	ispc::FISPCPhysicsQueue* KernelQueue = reinterpret_cast<ispc::FISPCPhysicsQueue*>(&Queue);
 
-		if (!HasValidData(Comp))
+	Kernel.PrePhysics(DeltaSeconds, KernelArrays, KernelQueue, Num, ChunkSize);
+
+	TArray<int32>& Pending = ISPCPhysicsQueue.Pending;
+	Pending.Reset(Num);
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		if (Queue.bPerformMovement[Index])
 		{
-			return;
+			Pending.Add(Index);
 		}
+	}
 
-		// Update character state based on change from movement
-		UpdateCharacterStateAfterMovement(Comp);
-
-		if ((Comp->bAllowPhysicsRotationDuringAnimRootMotion || !HasAnimRootMotion(Comp)) && !Comp->CharacterOwner->IsMatineeControlled())
+	TArray<int32, TInlineAllocator<64>> Requeued;
+	for (int32 Pass = 0; Pending.Num() > 0; ++Pass)
+	{
+		if (Pass == MaxBucketingPasses)
 		{
-			PhysicsRotation(Comp, DeltaSeconds);
+			Kernel.TickRequeued(KernelArrays, KernelQueue, Pending.GetData(), Pending.Num(), ChunkSize);
+			break;
 		}
 
-		// Apply Root Motion rotation after movement is complete.
-		if (HasAnimRootMotion(Comp))
 		{
-#if 1	// TODO ISPC
-			unimplemented();
-#else
-			const FQuat OldActorRotationQuat = Comp->UpdatedComponent->GetComponentQuat();
-			const FQuat RootMotionRotationQuat = Comp->RootMotionParams.GetRootMotionTransform().GetRotation();
-			if (!RootMotionRotationQuat.IsIdentity())
+			SCOPE_CYCLE_COUNTER(STAT_CharacterMovementISPCBucketing);
+
+			// Movement mode picks the kernel. Crouched state and movement base only order the bots within a
+			// bucket, so that gangs also agree on the crouch and based movement paths.
+			uint32* BucketKeys = ISPCPhysicsQueue.BucketKeys.GetData();
+			for (int32 Index : Pending)
 			{
-				const FQuat NewActorRotationQuat = RootMotionRotationQuat * OldActorRotationQuat;
-				Comp->MoveUpdatedComponent(FVector::ZeroVector, NewActorRotationQuat, true);
+				BucketKeys[Index] = ((uint32)Arrays.MovementMode[Index] << 2)
+					| ((uint32)Arrays.CharacterOwner_bIsCrouched[Index] << 1)
+					| (Arrays.CharacterOwner_MovementBase[Index] != nullptr ? 1 : 0);
 			}
-
-#if !(UE_BUILD_SHIPPING)
-			// debug
-			if (false)
+			Pending.Sort([BucketKeys](int32 A, int32 B)
 			{
-				const FRotator OldActorRotation = OldActorRotationQuat.Rotator();
-				const FVector ResultingLocation = Comp->UpdatedComponent->GetComponentLocation();
-				const FRotator ResultingRotation = Comp->UpdatedComponent->GetComponentRotation();
-
-				// Show current position
-				DrawDebugCoordinateSystem(GetWorld(), Comp->CharacterOwner->GetMesh()->GetComponentLocation() + FVector(0, 0, 1), ResultingRotation, 50.f, false);
-
-				// Show resulting delta move.
-				DrawDebugLine(GetWorld(), OldLocation, ResultingLocation, FColor::Red, true, 10.f);
+				return BucketKeys[A] < BucketKeys[B] || (BucketKeys[A] == BucketKeys[B] && A < B);
+			});
+		}
 
-				// Log details.
-				UE_LOG(LogRootMotion, Warning, TEXT("PerformMovement Resulting DeltaMove Translation: %s, Rotation: %s, MovementBase: %s"),
-					*(ResultingLocation - OldLocation).ToCompactString(), *(ResultingRotation - OldActorRotation).GetNormalized().ToCompactString(), *GetNameSafe(Comp->CharacterOwner->GetMovementBase()));
+		for (int32 Begin = 0; Begin < Pending.Num();)
+		{
+			const EMovementMode Mode = Arrays.MovementMode[Pending[Begin]];
+			int32 End = Begin + 1;
+			while (End < Pending.Num() && Arrays.MovementMode[Pending[End]] == Mode)
+			{
+				++End;
+			}
 
-				const FVector RMTranslation = Comp->RootMotionParams.GetRootMotionTransform().GetTranslation();
-				const FRotator RMRotation = Comp->RootMotionParams.GetRootMotionTransform().GetRotation().Rotator();
-				UE_LOG(LogRootMotion, Warning, TEXT("PerformMovement Resulting DeltaError Translation: %s, Rotation: %s"),
-					*(ResultingLocation - OldLocation - RMTranslation).ToCompactString(), *(ResultingRotation - OldActorRotation - RMRotation).GetNormalized().ToCompactString());
+			const int32* Indices = Pending.GetData() + Begin;
+			const int32 Count = End - Begin;
+			switch (Mode)
+			{
+			case MOVE_Walking:
+				Kernel.TickWalking(KernelArrays, KernelQueue, Indices, Count, ChunkSize);
+				break;
+			case MOVE_Falling:
+				Kernel.TickFalling(KernelArrays, KernelQueue, Indices, Count, ChunkSize);
+				break;
+			case MOVE_NavWalking:
+				Kernel.TickNavWalking(KernelArrays, KernelQueue, Indices, Count, ChunkSize);
+				break;
+			default:
+				Kernel.TickOtherMode(KernelArrays, KernelQueue, Indices, Count, ChunkSize, (ispc::EMovementMode)Mode);
+				break;
 			}
-#endif // !(UE_BUILD_SHIPPING)
+			INC_DWORD_STAT(STAT_CharacterMovementISPCBuckets);
 
-			// Root Motion has been used, clear
-			Comp->RootMotionParams.Clear();
-#endif	// TODO ISPC
+			Begin = End;
 		}
 
-		// consume path following requested velocity
-		Comp->bHasRequestedVelocity = false;
+		Requeued.Reset();
+		for (int32 Index : Pending)
+		{
+			if (Queue.bRequeued[Index])
+			{
+				Requeued.Add(Index);
+			}
+		}
+		INC_DWORD_STAT_BY(STAT_CharacterMovementISPCRequeued, Requeued.Num());
+		Pending = Requeued;
+	}
 
-#if 0	// TODO ISPC: This is an empty method, don't call at all for now.
-		Comp->OnMovementUpdated(DeltaSeconds, OldLocation, OldVelocity);
-#endif
-	} // End scoped movement update
+	Kernel.PostPhysics(DeltaSeconds, KernelArrays, KernelQueue, Num, ChunkSize);
+}
 
-	// Call external post-movement events. These happen after the scoped movement completes in case the events want to use the current state of overlaps etc.
-	CallMovementUpdateDelegate(Comp, DeltaSeconds, OldLocation, OldVelocity);
+void UShooterUnrolledCppMovementSystem::GatherISPCStore()
+{
+	SCOPE_CYCLE_COUNTER(STAT_CharacterMovementISPCGather);
+
+	static const uint32 KernelMovementModes = ispc::GetKernelMovementModes();
+	ISPCScalarBots.Reset();
+
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		UShooterUnrolledCppMovement* Comp = Components[Index];
+		USceneComponent* UpdatedComponent = Comp->UpdatedComponent;
+		ACharacter* CharacterOwner = Comp->CharacterOwner;
+		UCapsuleComponent* Capsule = CharacterOwner ? CharacterOwner->GetCapsuleComponent() : nullptr;
+
+		ISPCStore.Comp[Index] = Comp;
+		ISPCStore.UpdatedComponent[Index] = UpdatedComponent;
+		ISPCStore.DeferredUpdatedMoveComponent[Index] = Comp->DeferredUpdatedMoveComponent;
+		ISPCStore.UpdatedPrimitive[Index] = Comp->UpdatedPrimitive;
+		ISPCStore.CharacterOwner[Index] = CharacterOwner;
+		ISPCStore.CharacterOwner_MovementBase[Index] = CharacterOwner ? CharacterOwner->GetMovementBase() : nullptr;
+		ISPCStore.UpdatedComponent_Owner[Index] = UpdatedComponent ? UpdatedComponent->GetOwner() : nullptr;
+		const FPooledCollisionParams& CollisionParams = GetCollisionParams(Comp);
+		ISPCStore.CollisionQueryParams[Index] = &CollisionParams.QueryParams[0];
+		ISPCStore.CollisionResponseParams[Index] = &CollisionParams.ResponseParams;
+
+		ISPCStore.UpdatedComponent_Mobility[Index] = UpdatedComponent ? UpdatedComponent->Mobility.GetValue() : EComponentMobility::Static;
+		ISPCStore.UpdatedComponent_IsSimulatingPhysics[Index] = UpdatedComponent && UpdatedComponent->IsSimulatingPhysics();
+		ISPCStore.UpdatedComponent_CollisionObjectType[Index] = UpdatedComponent ? UpdatedComponent->GetCollisionObjectType() : ECC_Pawn;
+		ISPCStore.UpdatedComponent_ComponentQuat[Index] = UpdatedComponent ? UpdatedComponent->GetComponentQuat() : FQuat::Identity;
+		ISPCStore.UpdatedComponent_ComponentLocation[Index] = UpdatedComponent ? UpdatedComponent->GetComponentLocation() : FVector::ZeroVector;
+		ISPCStore.UpdatedComponent_ComponentScale[Index] = UpdatedComponent ? UpdatedComponent->GetComponentScale() : FVector(1.f);
+
+		if (CharacterOwner)
+		{
+			// TODO ISPC: Cache this.
+			const UCapsuleComponent* DefaultCapsule = CharacterOwner->GetClass()->GetDefaultObject<ACharacter>()->GetCapsuleComponent();
+
+			ISPCStore.CharacterOwner_Role[Index] = CharacterOwner->Role;
+			ISPCStore.CharacterOwner_bClientUpdating[Index] = CharacterOwner->bClientUpdating;
+			ISPCStore.CharacterOwner_IsPlayingRootMotion[Index] = CharacterOwner->IsPlayingRootMotion();
+			ISPCStore.CharacterOwner_bServerMoveIgnoreRootMotion[Index] = CharacterOwner->bServerMoveIgnoreRootMotion;
+			ISPCStore.CharacterOwner_IsMatineeControlled[Index] = CharacterOwner->IsMatineeControlled();
+			ISPCStore.CharacterOwner_HasAuthority[Index] = CharacterOwner->HasAuthority();
+			ISPCStore.CharacterOwner_GetMesh[Index] = CharacterOwner->GetMesh();
+			ISPCStore.CharacterOwner_bIsCrouched[Index] = CharacterOwner->bIsCrouched;
+			ISPCStore.DefaultCharacter_CapsuleComponent_UnscaledSize[Index] = FVector2D(DefaultCapsule->GetUnscaledCapsuleRadius(), DefaultCapsule->GetUnscaledCapsuleHalfHeight());
+			ISPCStore.CharacterOwner_CapsuleComponent_Size[Index] = FVector(Capsule->GetUnscaledCapsuleRadius(), Capsule->GetUnscaledCapsuleHalfHeight(), Capsule->GetShapeScale());
+			ISPCStore.PawnCapsuleCollisionShape_ShrinkCapsuleExtent_None[Index] = Comp->GetPawnCapsuleCollisionShape(UCharacterMovementComponent::EShrinkCapsuleExtent::SHRINK_None);
+		}
+
+		ISPCStore.NavAgentProps_bCanCrouch[Index] = Comp->NavAgentProps.bCanCrouch;
+		ISPCStore.CurrentRootMotion_HasActiveRootMotionSources[Index] = Comp->CurrentRootMotion.HasActiveRootMotionSources();
+		ISPCStore.RootMotionParams_bHasRootMotion[Index] = Comp->RootMotionParams.bHasRootMotion;
+
+		ISPCStore.NetMode[Index] = Comp->GetNetMode();
+		ISPCStore.bCrouchMaintainsBaseLocation[Index] = Comp->bCrouchMaintainsBaseLocation;
+		ISPCStore.bWantsToCrouch[Index] = Comp->bWantsToCrouch;
+		ISPCStore.bWantsToLeaveNavWalking[Index] = Comp->bWantsToLeaveNavWalking;
+		ISPCStore.bAllowPhysicsRotationDuringAnimRootMotion[Index] = Comp->bAllowPhysicsRotationDuringAnimRootMotion;
+		ISPCStore.CrouchedHalfHeight[Index] = Comp->CrouchedHalfHeight;
+		ISPCStore.GravityScale[Index] = Comp->GravityScale;
+		ISPCStore.BrakingFrictionFactor[Index] = Comp->BrakingFrictionFactor;
+		ISPCStore.MaxSimulationIterations[Index] = Comp->MaxSimulationIterations;
+		ISPCStore.MoveComponentFlags[Index] = Comp->MoveComponentFlags;
+		ISPCStore.WalkableFloorZ[Index] = Comp->GetWalkableFloorZ();
+
+		ISPCStore.SetCurrentFloor(Index, Comp->CurrentFloor);
+		ISPCStore.MovementMode[Index] = Comp->MovementMode;
+		ISPCStore.bScalarFallback[Index] = (KernelMovementModes & (1u << Comp->MovementMode)) == 0;
+		if (ISPCStore.bScalarFallback[Index])
+		{
+			ISPCScalarBots.Add(Comp);
+		}
+
+		ISPCStore.PendingImpulseToApply[Index] = Comp->PendingImpulseToApply;
+		ISPCStore.PendingForceToApply[Index] = Comp->PendingForceToApply;
+		ISPCStore.PendingLaunchVelocity[Index] = Comp->PendingLaunchVelocity;
+
+		ISPCStore.bForceNextFloorCheck[Index] = Comp->bForceNextFloorCheck;
+		ISPCStore.bShrinkProxyCapsule[Index] = Comp->bShrinkProxyCapsule;
+		ISPCStore.bDeferUpdateBasedMovement[Index] = Comp->bDeferUpdateBasedMovement;
+		ISPCStore.bDeferUpdateMoveComponent[Index] = Comp->bDeferUpdateMoveComponent;
+		ISPCStore.bHasRequestedVelocity[Index] = Comp->bHasRequestedVelocity;
+		ISPCStore.bMovementInProgress[Index] = Comp->bMovementInProgress;
+		ISPCStore.bJustTeleported[Index] = Comp->bJustTeleported;
+
+		ISPCStore.LastUpdateLocation[Index] = Comp->LastUpdateLocation;
+		ISPCStore.LastUpdateRotation[Index] = Comp->LastUpdateRotation;
+		ISPCStore.LastUpdateVelocity[Index] = Comp->LastUpdateVelocity;
+		ISPCStore.Velocity[Index] = Comp->Velocity;
+
+		ISPCStore.ServerLastTransformUpdateTimeStamp[Index] = Comp->ServerLastTransformUpdateTimeStamp;
+	}
+}
 
-	MaybeSaveBaseLocation(Comp);
-	UpdateComponentVelocity(Comp);
+void UShooterUnrolledCppMovementSystem::ScatterISPCStore()
+{
+	SCOPE_CYCLE_COUNTER(STAT_CharacterMovementISPCScatter);
 
-	const bool bHasAuthority = Comp->CharacterOwner && Comp->CharacterOwner->HasAuthority();
+	// ISPC: Only the fields the kernel owns are written back. Transforms, capsule sizes and
+	// everything else on the scene components has already been applied through the callbacks;
+	// the transform and capsule snapshot is read-only to the kernel apart from those callbacks.
+	// Comparing first keeps untouched components (and their cache lines) clean.
+#define SCATTER_IF_CHANGED(Dest, Field)				\
+	if (!(Dest == ISPCStore.Field[Index]))			\
+	{												\
+		Dest = ISPCStore.Field[Index];				\
+	}
 
-	// TODO ISPC: Uniformize UNetDriver::IsAdaptiveNetUpdateFrequencyEnabled() and foreach_active this entire if.
-	// If we move we want to avoid a long delay before replication catches up to notice this change, especially if it's throttling our rate.
-	if (bHasAuthority && UNetDriver::IsAdaptiveNetUpdateFrequencyEnabled() && Comp->UpdatedComponent)
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
 	{
-		const UWorld* MyWorld = GetWorld();
-		if (MyWorld)
+		if (ISPCStore.bScalarFallback[Index])
 		{
-			UNetDriver* NetDriver = MyWorld->GetNetDriver();
-			if (NetDriver && NetDriver->IsServer())
-			{
-				FNetworkObjectInfo* NetActor = NetDriver->FindOrAddNetworkObjectInfo(Comp->CharacterOwner);
-
-				if (NetActor && MyWorld->GetTimeSeconds() <= NetActor->NextUpdateTime && NetDriver->IsNetworkActorUpdateFrequencyThrottled(*NetActor))
-				{
-					if (Comp->ShouldCancelAdaptiveReplication())
-					{
-						NetDriver->CancelAdaptiveReplication(*NetActor);
-					}
-				}
-			}
+			// Not touched by the kernel.
+			continue;
 		}
-	}
-
-	const FVector NewLocation = Comp->UpdatedComponent ? Comp->UpdatedComponent->GetComponentLocation() : FVector::ZeroVector;
-	const FQuat NewRotation = Comp->UpdatedComponent ? Comp->UpdatedComponent->GetComponentQuat() : FQuat::Identity;
+		UShooterUnrolledCppMovement* Comp = Components[Index];
 
-	if (bHasAuthority && Comp->UpdatedComponent && !Comp->IsNetMode(NM_Client))
-	{
-		const bool bLocationChanged = (NewLocation != Comp->LastUpdateLocation);
-		const bool bRotationChanged = (NewRotation != Comp->LastUpdateRotation);
-		if (bLocationChanged || bRotationChanged)
+		// The cold part of the floor is only read back if the kernel replaced the whole record.
+		if (ISPCStore.CurrentFloor_bColdDirty[Index])
 		{
-			const UWorld* MyWorld = GetWorld();
-			Comp->ServerLastTransformUpdateTimeStamp = MyWorld ? MyWorld->GetTimeSeconds() : 0.f;
+			Comp->CurrentFloor = ISPCStore.GetCurrentFloor(Index);
+		}
+		else if (ISPCStore.CurrentFloorHotFieldsDiffer(Index, Comp->CurrentFloor))
+		{
+			ISPCStore.GetCurrentFloorHotFields(Index, Comp->CurrentFloor);
+		}
+		SCATTER_IF_CHANGED(Comp->MovementMode, MovementMode);
+		if (Comp->CharacterOwner)
+		{
+			SCATTER_IF_CHANGED(Comp->CharacterOwner->bIsCrouched, CharacterOwner_bIsCrouched);
 		}
-	}
 
-	Comp->LastUpdateLocation = NewLocation;
-	Comp->LastUpdateRotation = NewRotation;
-	Comp->LastUpdateVelocity = Comp->Velocity;
-}
+		SCATTER_IF_CHANGED(Comp->PendingImpulseToApply, PendingImpulseToApply);
+		SCATTER_IF_CHANGED(Comp->PendingForceToApply, PendingForceToApply);
+		SCATTER_IF_CHANGED(Comp->PendingLaunchVelocity, PendingLaunchVelocity);
 
-void UShooterUnrolledCppMovementSystem::Tick(float DeltaSeconds)
-{
-	for (auto* Comp : Components)
-	{
-		PerformMovement(Comp, DeltaSeconds);
+		SCATTER_IF_CHANGED(Comp->bForceNextFloorCheck, bForceNextFloorCheck);
+		SCATTER_IF_CHANGED(Comp->bShrinkProxyCapsule, bShrinkProxyCapsule);
+		SCATTER_IF_CHANGED(Comp->bDeferUpdateBasedMovement, bDeferUpdateBasedMovement);
+		SCATTER_IF_CHANGED(Comp->bDeferUpdateMoveComponent, bDeferUpdateMoveComponent);
+		SCATTER_IF_CHANGED(Comp->bHasRequestedVelocity, bHasRequestedVelocity);
+		SCATTER_IF_CHANGED(Comp->bMovementInProgress, bMovementInProgress);
+		SCATTER_IF_CHANGED(Comp->bJustTeleported, bJustTeleported);
+
+		SCATTER_IF_CHANGED(Comp->LastUpdateLocation, LastUpdateLocation);
+		SCATTER_IF_CHANGED(Comp->LastUpdateRotation, LastUpdateRotation);
+		SCATTER_IF_CHANGED(Comp->LastUpdateVelocity, LastUpdateVelocity);
+		SCATTER_IF_CHANGED(Comp->Velocity, Velocity);
+
+		SCATTER_IF_CHANGED(Comp->ServerLastTransformUpdateTimeStamp, ServerLastTransformUpdateTimeStamp);
 	}
+
+#undef SCATTER_IF_CHANGED
 }
 
 void UShooterUnrolledCppMovementSystem::CallMovementUpdateDelegate(UShooterUnrolledCppMovement* Comp, float DeltaTime, const FVector& OldLocation, const FVector& OldVelocity)
@@ -578,7 +1504,17 @@ void UShooterUnrolledCppMovementSystem::CallMovementUpdateDelegate(UShooterUnrol
 	if (Comp->CharacterOwner)
 	{
 		// TODO ISPC: foreach_active
-		Comp->CharacterOwner->OnCharacterMovementUpdated.Broadcast(DeltaTime, OldLocation, OldVelocity);
+		ACharacter* CharacterOwner = Comp->CharacterOwner;
+		const bool bQueued = FMovementEventQueue::TryQueue(EMovementEventType::MovementUpdated, Comp, Comp->SystemIndex, CharacterOwner, [&](FMovementEvent& Event)
+		{
+			Event.Time = DeltaTime;
+			Event.Location = OldLocation;
+			Event.Velocity = OldVelocity;
+		});
+		if (!bQueued)
+		{
+			ParallelMovement::DeferOrRun([CharacterOwner, DeltaTime, OldLocation, OldVelocity]() { CharacterOwner->OnCharacterMovementUpdated.Broadcast(DeltaTime, OldLocation, OldVelocity); });
+		}
 	}
 }
 
@@ -605,21 +1541,40 @@ void UShooterUnrolledCppMovementSystem::UpdateCharacterStateAfterMovement(UShoot
 	}
 }
 
-void UShooterUnrolledCppMovementSystem::StartNewPhysics(UShooterUnrolledCppMovement* Comp, float deltaTime, int32 Iterations)
+bool UShooterUnrolledCppMovementSystem::BeginNewPhysics(UShooterUnrolledCppMovement* Comp, float deltaTime, int32 Iterations, bool& bOutSavedMovementInProgress)
 {
 	if ((deltaTime < UCharacterMovementComponent::MIN_TICK_TIME) || (Iterations >= Comp->MaxSimulationIterations) || !HasValidData(Comp))
 	{
-		return;
+		return false;
 	}
 
 	if (Comp->UpdatedComponent->IsSimulatingPhysics())
 	{
 		UE_LOG(LogUnrolledCharacterMovement, Log, TEXT("UCharacterMovementComponent::StartNewPhysics: UpdateComponent (%s) is simulating physics - aborting."), *Comp->UpdatedComponent->GetPathName());
-		return;
+		return false;
 	}
 
-	const bool bSavedMovementInProgress = Comp->bMovementInProgress;
+	bOutSavedMovementInProgress = Comp->bMovementInProgress;
 	Comp->bMovementInProgress = true;
+	return true;
+}
+
+void UShooterUnrolledCppMovementSystem::EndNewPhysics(UShooterUnrolledCppMovement* Comp, bool bSavedMovementInProgress)
+{
+	Comp->bMovementInProgress = bSavedMovementInProgress;
+	if (Comp->bDeferUpdateMoveComponent)
+	{
+		SetUpdatedComponent(Comp, Comp->DeferredUpdatedMoveComponent);
+	}
+}
+
+void UShooterUnrolledCppMovementSystem::StartNewPhysics(UShooterUnrolledCppMovement* Comp, float deltaTime, int32 Iterations)
+{
+	bool bSavedMovementInProgress;
+	if (!BeginNewPhysics(Comp, deltaTime, Iterations, bSavedMovementInProgress))
+	{
+		return;
+	}
 
 	switch (Comp->MovementMode)
 	{
@@ -649,11 +1604,7 @@ void UShooterUnrolledCppMovementSystem::StartNewPhysics(UShooterUnrolledCppMovem
 		break;
 	}
 
-	Comp->bMovementInProgress = bSavedMovementInProgress;
-	if (Comp->bDeferUpdateMoveComponent)
-	{
-		SetUpdatedComponent(Comp, Comp->DeferredUpdatedMoveComponent);
-	}
+	EndNewPhysics(Comp, bSavedMovementInProgress);
 }
 
 bool UShooterUnrolledCppMovementSystem::IsFlying(UShooterUnrolledCppMovement* Comp) const
@@ -691,9 +1642,24 @@ APhysicsVolume* UShooterUnrolledCppMovementSystem::GetPhysicsVolume(UShooterUnro
 	return GetWorld()->GetDefaultPhysicsVolume();
 }
 
+void UShooterUnrolledCppMovementSystem::UpdatePhysicsVolumeSnapshot(UShooterUnrolledCppMovement* Comp)
+{
+	const int32 Index = Comp->SystemIndex;
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	const APhysicsVolume* PhysicsVolume = GetPhysicsVolume(Comp);
+	ISPCStore.PhysicsVolume_GravityZ[Index] = PhysicsVolume->GetGravityZ();
+	ISPCStore.PhysicsVolume_bWaterVolume[Index] = PhysicsVolume->bWaterVolume;
+	ISPCStore.PhysicsVolume_FluidFriction[Index] = PhysicsVolume->FluidFriction;
+	ISPCStore.PhysicsVolume_TerminalVelocity[Index] = PhysicsVolume->TerminalVelocity;
+}
+
 float UShooterUnrolledCppMovementSystem::GetGravityZ(UShooterUnrolledCppMovement* Comp) const
 {
-	return (GetPhysicsVolume(Comp)->GetGravityZ()) * Comp->GravityScale;
+	return ISPCStore.PhysicsVolume_GravityZ[Comp->SystemIndex] * Comp->GravityScale;
 }
 
 float UShooterUnrolledCppMovementSystem::GetMaxSpeed(UShooterUnrolledCppMovement* Comp) const
@@ -774,8 +1740,7 @@ float UShooterUnrolledCppMovementSystem::GetValidPerchRadius(UShooterUnrolledCpp
 
 bool UShooterUnrolledCppMovementSystem::IsInWater(UShooterUnrolledCppMovement* Comp) const
 {
-	const APhysicsVolume* PhysVolume = GetPhysicsVolume(Comp);
-	return PhysVolume && PhysVolume->bWaterVolume;
+	return ISPCStore.PhysicsVolume_bWaterVolume[Comp->SystemIndex];
 }
 
 bool UShooterUnrolledCppMovementSystem::IsValidLandingSpot(UShooterUnrolledCppMovement* Comp, const FVector& CapsuleLocation, const FHitResult& Hit) const
@@ -1135,7 +2100,8 @@ void UShooterUnrolledCppMovementSystem::PhysWalking(UShooterUnrolledCppMovement*
 			{
 				if (Comp->ShouldCatchAir(OldFloor, Comp->CurrentFloor))
 				{
-					Comp->CharacterOwner->OnWalkingOffLedge(OldFloor.HitResult.ImpactNormal, OldFloor.HitResult.Normal, OldLocation, timeTick);
+					ParallelMovement::DeferOrRun([CharacterOwner = Comp->CharacterOwner, PreviousFloorImpactNormal = OldFloor.HitResult.ImpactNormal, PreviousFloorContactNormal = OldFloor.HitResult.Normal, OldLocation, timeTick]()
+						{ CharacterOwner->OnWalkingOffLedge(PreviousFloorImpactNormal, PreviousFloorContactNormal, OldLocation, timeTick); });
 					if (IsMovingOnGround(Comp))
 					{
 						// If still walking, then fall. If not, assume the user set a different mode they want to keep.
@@ -1205,20 +2171,35 @@ void UShooterUnrolledCppMovementSystem::PhysWalking(UShooterUnrolledCppMovement*
 
 void UShooterUnrolledCppMovementSystem::PhysNavWalking(UShooterUnrolledCppMovement* Comp, float deltaTime, int32 Iterations)
 {
-	unimplemented();
-#if 0	// TODO ISPC
 	SCOPE_CYCLE_COUNTER(STAT_CharPhysNavWalking);
 
-	if (deltaTime < UCharacterMovementComponent::MIN_TICK_TIME)
+	FNavWalkingMove Move;
+	if (!BeginPhysNavWalking(Comp, deltaTime, Iterations, Move))
 	{
 		return;
 	}
 
+	if (Move.bNeedsProjection)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_CharNavProjectPoint);
+		Move.bHasNavigationData = FindNavFloor(Comp, Move.AdjustedDest, Move.DestNavLocation);
+	}
+
+	FinishPhysNavWalking(Move);
+}
+
+bool UShooterUnrolledCppMovementSystem::BeginPhysNavWalking(UShooterUnrolledCppMovement* Comp, float deltaTime, int32 Iterations, FNavWalkingMove& OutMove)
+{
+	if (deltaTime < UCharacterMovementComponent::MIN_TICK_TIME)
+	{
+		return false;
+	}
+
 	if ((!Comp->CharacterOwner || !Comp->CharacterOwner->Controller) && !Comp->bRunPhysicsWithNoController && !HasAnimRootMotion(Comp) && !Comp->CurrentRootMotion.HasOverrideVelocity())
 	{
 		Comp->Acceleration = FVector::ZeroVector;
 		Comp->Velocity = FVector::ZeroVector;
-		return;
+		return false;
 	}
 
 	RestorePreAdditiveRootMotionVelocity(Comp);
@@ -1241,7 +2222,7 @@ void UShooterUnrolledCppMovementSystem::PhysNavWalking(UShooterUnrolledCppMoveme
 	{
 		// Root motion could have put us into Falling
 		StartNewPhysics(Comp, deltaTime, Iterations);
-		return;
+		return false;
 	}
 
 	Iterations++;
@@ -1249,106 +2230,285 @@ void UShooterUnrolledCppMovementSystem::PhysNavWalking(UShooterUnrolledCppMoveme
 	FVector DesiredMove = Comp->Velocity;
 	DesiredMove.Z = 0.f;
 
-	const FVector OldLocation = GetActorFeetLocation(Comp);
-	const FVector DeltaMove = DesiredMove * deltaTime;
-
-	FVector AdjustedDest = OldLocation + DeltaMove;
-	FNavLocation DestNavLocation;
+	OutMove.Comp = Comp;
+	OutMove.DeltaTime = deltaTime;
+	OutMove.Iterations = Iterations;
+	OutMove.OldLocation = GetActorFeetLocation(Comp);
+	OutMove.DeltaMove = DesiredMove * deltaTime;
+	OutMove.AdjustedDest = OutMove.OldLocation + OutMove.DeltaMove;
 
 	bool bSameNavLocation = false;
 	if (Comp->CachedNavLocation.NodeRef != INVALID_NAVNODEREF)
 	{
 		if (Comp->bProjectNavMeshWalking)
 		{
-			const float DistSq2D = (OldLocation - Comp->CachedNavLocation.Location).SizeSquared2D();
-			const float DistZ = FMath::Abs(OldLocation.Z - Comp->CachedNavLocation.Location.Z);
+			const float DistSq2D = (OutMove.OldLocation - Comp->CachedNavLocation.Location).SizeSquared2D();
+			const float DistZ = FMath::Abs(OutMove.OldLocation.Z - Comp->CachedNavLocation.Location.Z);
 
 			const float TotalCapsuleHeight = Comp->CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() * 2.0f;
-			const float ProjectionScale = (OldLocation.Z > Comp->CachedNavLocation.Location.Z) ? Comp->NavMeshProjectionHeightScaleUp : Comp->NavMeshProjectionHeightScaleDown;
+			const float ProjectionScale = (OutMove.OldLocation.Z > Comp->CachedNavLocation.Location.Z) ? Comp->NavMeshProjectionHeightScaleUp : Comp->NavMeshProjectionHeightScaleDown;
 			const float DistZThr = TotalCapsuleHeight * FMath::Max(0.f, ProjectionScale);
 
 			bSameNavLocation = (DistSq2D <= KINDA_SMALL_NUMBER) && (DistZ < DistZThr);
 		}
 		else
 		{
-			bSameNavLocation = Comp->CachedNavLocation.Location.Equals(OldLocation);
+			bSameNavLocation = Comp->CachedNavLocation.Location.Equals(OutMove.OldLocation);
 		}
 	}
-		
 
-	if (DeltaMove.IsNearlyZero() && bSameNavLocation)
+	if (OutMove.DeltaMove.IsNearlyZero() && bSameNavLocation)
 	{
-		DestNavLocation = Comp->CachedNavLocation;
+		OutMove.DestNavLocation = Comp->CachedNavLocation;
+		OutMove.bNeedsProjection = false;
 		UE_LOG(LogUnrolledNavMeshMovement, VeryVerbose, TEXT("%s using cached navmesh location! (bProjectNavMeshWalking = %d)"), *GetNameSafe(Comp->CharacterOwner), Comp->bProjectNavMeshWalking);
 	}
 	else
 	{
-		SCOPE_CYCLE_COUNTER(STAT_CharNavProjectPoint);
-
 		// Start the trace from the Z location of the last valid trace.
 		// Otherwise if we are projecting our location to the underlying geometry and it's far above or below the navmesh,
 		// we'll follow that geometry's plane out of range of valid navigation.
 		if (bSameNavLocation && Comp->bProjectNavMeshWalking)
 		{
-			AdjustedDest.Z = Comp->CachedNavLocation.Location.Z;
+			OutMove.AdjustedDest.Z = Comp->CachedNavLocation.Location.Z;
 		}
 
-		// Find the point on the NavMesh
-		const bool bHasNavigationData = FindNavFloor(Comp, AdjustedDest, DestNavLocation);
-		if (!bHasNavigationData)
+		// The point on the NavMesh is found by the caller, see FindNavFloor() and FindNavFloors().
+		OutMove.bNeedsProjection = true;
+	}
+
+	return true;
+}
+
+void UShooterUnrolledCppMovementSystem::FinishPhysNavWalking(const FNavWalkingMove& Move)
+{
+	UShooterUnrolledCppMovement* Comp = Move.Comp;
+
+	if (Move.bNeedsProjection)
+	{
+		if (!Move.bHasNavigationData)
 		{
 			SetMovementMode(Comp, MOVE_Walking);
 			return;
 		}
 
-		Comp->CachedNavLocation = DestNavLocation;
+		Comp->CachedNavLocation = Move.DestNavLocation;
 	}
 
-	if (DestNavLocation.NodeRef != INVALID_NAVNODEREF)
+	if (Move.DestNavLocation.NodeRef != INVALID_NAVNODEREF)
 	{
-		FVector NewLocation(AdjustedDest.X, AdjustedDest.Y, DestNavLocation.Location.Z);
+		FVector NewLocation(Move.AdjustedDest.X, Move.AdjustedDest.Y, Move.DestNavLocation.Location.Z);
 		if (Comp->bProjectNavMeshWalking)
 		{
 			SCOPE_CYCLE_COUNTER(STAT_CharNavProjectLocation);
 			const float TotalCapsuleHeight = Comp->CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() * 2.0f;
 			const float UpOffset = TotalCapsuleHeight * FMath::Max(0.f, Comp->NavMeshProjectionHeightScaleUp);
 			const float DownOffset = TotalCapsuleHeight * FMath::Max(0.f, Comp->NavMeshProjectionHeightScaleDown);
-			NewLocation = ProjectLocationFromNavMesh(Comp-> deltaTime, OldLocation, NewLocation, UpOffset, DownOffset);
+			NewLocation = Comp->ProjectLocationFromNavMesh(Move.DeltaTime, Move.OldLocation, NewLocation, UpOffset, DownOffset);
 		}
 
-		FVector AdjustedDelta = NewLocation - OldLocation;
+		FVector AdjustedDelta = NewLocation - Move.OldLocation;
 
 		if (!AdjustedDelta.IsNearlyZero())
 		{
 			FHitResult HitResult;
 			const /*uniform*/ bool bMoveIgnoreFirstBlockingOverlap = !!CVars::MoveIgnoreFirstBlockingOverlap->GetInt();
-			SafeMoveUpdatedComponent(Comp, AdjustedDelta, UpdatedComponent->GetComponentQuat(), bSweepWhileNavWalking, HitResult);
+			SafeMoveUpdatedComponent(Comp, bMoveIgnoreFirstBlockingOverlap, AdjustedDelta, Comp->UpdatedComponent->GetComponentQuat(), Comp->bSweepWhileNavWalking, HitResult);
 		}
 
 		// Update velocity to reflect actual move
-		if (!bJustTeleported && !HasAnimRootMotion(Comp) && !Comp->CurrentRootMotion.HasVelocity())
+		if (!Comp->bJustTeleported && !HasAnimRootMotion(Comp) && !Comp->CurrentRootMotion.HasVelocity())
 		{
-			Comp->Velocity = (GetActorFeetLocation(Comp) - OldLocation) / deltaTime;
+			Comp->Velocity = (GetActorFeetLocation(Comp) - Move.OldLocation) / Move.DeltaTime;
 			MaintainHorizontalGroundVelocity(Comp);
 		}
 
-		bJustTeleported = false;
+		Comp->bJustTeleported = false;
 	}
 	else
 	{
-		StartFalling(Comp, Iterations, deltaTime, deltaTime, DeltaMove, OldLocation);
+		StartFalling(Comp, Move.Iterations, Move.DeltaTime, Move.DeltaTime, Move.DeltaMove, Move.OldLocation);
 	}
-#endif	// TODO ISPC
 }
 
 void UShooterUnrolledCppMovementSystem::PhysFlying(UShooterUnrolledCppMovement* Comp, float deltaTime, int32 Iterations)
 {
-	unimplemented();
+	if (deltaTime < UCharacterMovementComponent::MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	RestorePreAdditiveRootMotionVelocity(Comp);
+
+	if( !HasAnimRootMotion(Comp) && !Comp->CurrentRootMotion.HasOverrideVelocity() )
+	{
+		if( Comp->bCheatFlying && Comp->Acceleration.IsZero() )
+		{
+			Comp->Velocity = FVector::ZeroVector;
+		}
+		const float Friction = 0.5f * ISPCStore.PhysicsVolume_FluidFriction[Comp->SystemIndex];
+		CalcVelocity(Comp, deltaTime, Friction, true, GetMaxBrakingDeceleration(Comp));
+	}
+
+	ApplyRootMotionToVelocity(Comp, deltaTime);
+
+	Iterations++;
+	Comp->bJustTeleported = false;
+
+	FVector OldLocation = Comp->UpdatedComponent->GetComponentLocation();
+	const FVector Adjusted = Comp->Velocity * deltaTime;
+	FHitResult Hit(1.f);
+	const /*uniform*/ bool bMoveIgnoreFirstBlockingOverlap = !!CVars::MoveIgnoreFirstBlockingOverlap->GetInt();
+	SafeMoveUpdatedComponent(Comp, bMoveIgnoreFirstBlockingOverlap, Adjusted, Comp->UpdatedComponent->GetComponentQuat(), true, Hit);
+
+	if (Hit.Time < 1.f)
+	{
+		const FVector GravDir = FVector(0.f, 0.f, -1.f);
+		const FVector VelDir = Comp->Velocity.GetSafeNormal();
+		const float UpDown = GravDir | VelDir;
+
+		bool bSteppedUp = false;
+		if ((FMath::Abs(Hit.ImpactNormal.Z) < 0.2f) && (UpDown < 0.5f) && (UpDown > -0.2f) && CanStepUp(Comp, Hit))
+		{
+			float stepZ = Comp->UpdatedComponent->GetComponentLocation().Z;
+			bSteppedUp = StepUp(Comp, GravDir, Adjusted * (1.f - Hit.Time), Hit);
+			if (bSteppedUp)
+			{
+				OldLocation.Z = Comp->UpdatedComponent->GetComponentLocation().Z + (OldLocation.Z - stepZ);
+			}
+		}
+
+		if (!bSteppedUp)
+		{
+			//adjust and try again
+			HandleImpact(Comp, Hit, deltaTime, Adjusted);
+			SlideAlongSurface(Comp, Adjusted, (1.f - Hit.Time), Hit.Normal, Hit, true);
+		}
+	}
+
+	if (!Comp->bJustTeleported && !HasAnimRootMotion(Comp) && !Comp->CurrentRootMotion.HasOverrideVelocity())
+	{
+		Comp->Velocity = (Comp->UpdatedComponent->GetComponentLocation() - OldLocation) / deltaTime;
+	}
 }
 
 void UShooterUnrolledCppMovementSystem::PhysSwimming(UShooterUnrolledCppMovement* Comp, float deltaTime, int32 Iterations)
 {
-	unimplemented();
+	if (deltaTime < UCharacterMovementComponent::MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	RestorePreAdditiveRootMotionVelocity(Comp);
+
+	float Depth = ImmersionDepth(Comp);
+	float NetBuoyancy = Comp->Buoyancy * Depth;
+	float OriginalAccelZ = Comp->Acceleration.Z;
+	bool bLimitedUpAccel = false;
+
+	if (!HasAnimRootMotion(Comp) && !Comp->CurrentRootMotion.HasOverrideVelocity() && (Comp->Velocity.Z > 0.33f * Comp->MaxSwimSpeed) && (NetBuoyancy != 0.f))
+	{
+		//damp positive Z out of water
+		Comp->Velocity.Z = FMath::Max(0.33f * Comp->MaxSwimSpeed, Comp->Velocity.Z * Depth*Depth);
+	}
+	else if (Depth < 0.65f)
+	{
+		bLimitedUpAccel = (Comp->Acceleration.Z > 0.f);
+		Comp->Acceleration.Z = FMath::Min(0.1f, Comp->Acceleration.Z);
+	}
+
+	Iterations++;
+	FVector OldLocation = Comp->UpdatedComponent->GetComponentLocation();
+	Comp->bJustTeleported = false;
+	if( !HasAnimRootMotion(Comp) && !Comp->CurrentRootMotion.HasOverrideVelocity() )
+	{
+		const float Friction = 0.5f * ISPCStore.PhysicsVolume_FluidFriction[Comp->SystemIndex] * Depth;
+		CalcVelocity(Comp, deltaTime, Friction, true, GetMaxBrakingDeceleration(Comp));
+		Comp->Velocity.Z += GetGravityZ(Comp) * deltaTime * (1.f - NetBuoyancy);
+	}
+
+	ApplyRootMotionToVelocity(Comp, deltaTime);
+
+	FVector Adjusted = Comp->Velocity * deltaTime;
+	FHitResult Hit(1.f);
+	float remainingTime = deltaTime * Swim(Comp, Adjusted, Hit);
+
+	//may have left water - if so, script might have set new physics mode
+	if (!IsSwimming(Comp))
+	{
+		StartNewPhysics(Comp, remainingTime, Iterations);
+		return;
+	}
+
+	if (Hit.Time < 1.f && Comp->CharacterOwner)
+	{
+		Comp->HandleSwimmingWallHit(Hit, deltaTime);
+		if (bLimitedUpAccel && (Comp->Velocity.Z >= 0.f))
+		{
+			// allow upward velocity at surface if against obstacle
+			Comp->Velocity.Z += OriginalAccelZ * deltaTime;
+			Adjusted = Comp->Velocity * (1.f - Hit.Time)*deltaTime;
+			Swim(Comp, Adjusted, Hit);
+			if (!IsSwimming(Comp))
+			{
+				StartNewPhysics(Comp, remainingTime, Iterations);
+				return;
+			}
+		}
+
+		const FVector GravDir = FVector(0.f,0.f,-1.f);
+		const FVector VelDir = Comp->Velocity.GetSafeNormal();
+		const float UpDown = GravDir | VelDir;
+
+		bool bSteppedUp = false;
+		if( (FMath::Abs(Hit.ImpactNormal.Z) < 0.2f) && (UpDown < 0.5f) && (UpDown > -0.2f) && CanStepUp(Comp, Hit))
+		{
+			float stepZ = Comp->UpdatedComponent->GetComponentLocation().Z;
+			const FVector RealVelocity = Comp->Velocity;
+			Comp->Velocity.Z = 1.f;	// HACK: since will be moving up, in case pawn leaves the water
+			bSteppedUp = StepUp(Comp, GravDir, Adjusted * (1.f - Hit.Time), Hit);
+			if (bSteppedUp)
+			{
+				//may have left water - if so, script might have set new physics mode
+				if (!IsSwimming(Comp))
+				{
+					StartNewPhysics(Comp, remainingTime, Iterations);
+					return;
+				}
+				OldLocation.Z = Comp->UpdatedComponent->GetComponentLocation().Z + (OldLocation.Z - stepZ);
+			}
+			Comp->Velocity = RealVelocity;
+		}
+
+		if (!bSteppedUp)
+		{
+			//adjust and try again
+			HandleImpact(Comp, Hit, deltaTime, Adjusted);
+			SlideAlongSurface(Comp, Adjusted, (1.f - Hit.Time), Hit.Normal, Hit, true);
+		}
+	}
+
+	if( !HasAnimRootMotion(Comp) && !Comp->CurrentRootMotion.HasOverrideVelocity() && !Comp->bJustTeleported && ((deltaTime - remainingTime) > KINDA_SMALL_NUMBER) && Comp->CharacterOwner )
+	{
+		bool bWaterJump = !IsInWater(Comp);
+		float velZ = Comp->Velocity.Z;
+		Comp->Velocity = (Comp->UpdatedComponent->GetComponentLocation() - OldLocation) / (deltaTime - remainingTime);
+		if (bWaterJump)
+		{
+			Comp->Velocity.Z = velZ;
+		}
+	}
+
+	if (!IsInWater(Comp) && IsSwimming(Comp))
+	{
+		SetMovementMode(Comp, MOVE_Falling); //in case script didn't change it (w/ zone change)
+	}
+
+	//may have left water - if so, script might have set new physics mode
+	if (!IsSwimming(Comp))
+	{
+		StartNewPhysics(Comp, remainingTime, Iterations);
+	}
 }
 
 void UShooterUnrolledCppMovementSystem::PhysCustom(UShooterUnrolledCppMovement* Comp, float deltaTime, int32 Iterations)
@@ -1622,14 +2782,10 @@ void UShooterUnrolledCppMovementSystem::SetMovementMode(UShooterUnrolledCppMovem
 	// If trying to use NavWalking but there is no navmesh, use walking instead.
 	if (NewMovementMode == MOVE_NavWalking)
 	{
-#if 1	// TODO ISPC
-		unimplemented();
-#else
 		if (Comp->GetNavData() == nullptr)
 		{
 			NewMovementMode = MOVE_Walking;
 		}
-#endif
 	}
 
 	// Do nothing if nothing is changing.
@@ -1714,23 +2870,17 @@ void UShooterUnrolledCppMovementSystem::OnMovementModeChanged(UShooterUnrolledCp
 	// Update collision settings if needed
 	if (Comp->MovementMode == MOVE_NavWalking)
 	{
-#if 1	// TODO ISPC
-		unimplemented();
-#else
-		Comp->SetNavWalkingPhysics(true);
+		// Game thread only: changes collision settings.
+		RunOnGameThread([&]() { Comp->SetNavWalkingPhysics(true); });
 		SetGroundMovementMode(Comp, Comp->MovementMode);
 		// Walking uses only XY velocity
 		Comp->Velocity.Z = 0.f;
-#endif
 	}
 	else if (PreviousMovementMode == MOVE_NavWalking)
 	{
-#if 1	// TODO ISPC
-		unimplemented();
-#else
 		if (Comp->MovementMode == Comp->DefaultLandMovementMode || Comp->IsWalking())
 		{
-			const bool bSucceeded = Comp->TryToLeaveNavWalking();
+			const bool bSucceeded = RunOnGameThread([&]() { return Comp->TryToLeaveNavWalking(); });
 			if (!bSucceeded)
 			{
 				return;
@@ -1738,9 +2888,8 @@ void UShooterUnrolledCppMovementSystem::OnMovementModeChanged(UShooterUnrolledCp
 		}
 		else
 		{
-			Comp->SetNavWalkingPhysics(false);
+			RunOnGameThread([&]() { Comp->SetNavWalkingPhysics(false); });
 		}
-#endif
 	}
 
 	// React to changes in the movement mode.
@@ -1786,16 +2935,24 @@ void UShooterUnrolledCppMovementSystem::OnMovementModeChanged(UShooterUnrolledCp
 	}
 
 	// TODO ISPC: foreach_active?
-	Comp->CharacterOwner->OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+	const bool bQueued = FMovementEventQueue::TryQueue(EMovementEventType::MovementModeChanged, Comp, Comp->SystemIndex, Comp->CharacterOwner, [&](FMovementEvent& Event)
+	{
+		Event.PreviousMovementMode = (uint8)PreviousMovementMode;
+		Event.PreviousCustomMode = PreviousCustomMode;
+	});
+	if (!bQueued)
+	{
+		RunOnGameThread([&]() { Comp->CharacterOwner->OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode); });
+	}
 	ensureMsgf(Comp->GetGroundMovementMode() == MOVE_Walking || Comp->GetGroundMovementMode() == MOVE_NavWalking, TEXT("Invalid GroundMovementMode %d. MovementMode: %d, PreviousMovementMode: %d"), Comp->GetGroundMovementMode(), Comp->MovementMode.GetValue(), PreviousMovementMode);
 };
 
 bool UShooterUnrolledCppMovementSystem::CheckLedgeDirection(UShooterUnrolledCppMovement* Comp, const FVector& OldLocation, const FVector& SideStep, const FVector& GravDir) const
 {
 	const FVector SideDest = OldLocation + SideStep;
-	FCollisionQueryParams CapsuleParams(SCENE_QUERY_STAT(CheckLedgeDirection), false, Comp->CharacterOwner);
-	FCollisionResponseParams ResponseParam;
-	InitCollisionParams(Comp, CapsuleParams, ResponseParam);
+	const FPooledCollisionParams& CollisionParams = GetCollisionParams(Comp);
+	const FCollisionQueryParams& CapsuleParams = CollisionParams.QueryParams[BQS_CheckLedgeDirection];
+	const FCollisionResponseParams& ResponseParam = CollisionParams.ResponseParams;
 	// ISPC: This can be cached, no point in unrolling.
 	const FCollisionShape CapsuleShape = Comp->GetPawnCapsuleCollisionShape(UCharacterMovementComponent::EShrinkCapsuleExtent::SHRINK_None);
 	const ECollisionChannel CollisionChannel = Comp->UpdatedComponent->GetCollisionObjectType();
@@ -1860,7 +3017,8 @@ bool UShooterUnrolledCppMovementSystem::CheckFall(UShooterUnrolledCppMovement* C
 
 	if (bMustJump || CanWalkOffLedges(Comp))
 	{
-		Comp->CharacterOwner->OnWalkingOffLedge(OldFloor.HitResult.ImpactNormal, OldFloor.HitResult.Normal, OldLocation, timeTick);
+		ParallelMovement::DeferOrRun([CharacterOwner = Comp->CharacterOwner, PreviousFloorImpactNormal = OldFloor.HitResult.ImpactNormal, PreviousFloorContactNormal = OldFloor.HitResult.Normal, OldLocation, timeTick]()
+			{ CharacterOwner->OnWalkingOffLedge(PreviousFloorImpactNormal, PreviousFloorContactNormal, OldLocation, timeTick); });
 		if (IsMovingOnGround(Comp))
 		{
 			// If still walking, then fall. If not, assume the user set a different mode they want to keep.
@@ -1873,7 +3031,121 @@ bool UShooterUnrolledCppMovementSystem::CheckFall(UShooterUnrolledCppMovement* C
 
 void UShooterUnrolledCppMovementSystem::StartSwimming(UShooterUnrolledCppMovement* Comp, FVector OldLocation, FVector OldVelocity, float timeTick, float remainingTime, int32 Iterations)
 {
-	unimplemented();
+	if (remainingTime < UCharacterMovementComponent::MIN_TICK_TIME || timeTick < UCharacterMovementComponent::MIN_TICK_TIME)
+	{
+		return;
+	}
+
+	if( !HasAnimRootMotion(Comp) && !Comp->CurrentRootMotion.HasOverrideVelocity() && !Comp->bJustTeleported )
+	{
+		Comp->Velocity = (Comp->UpdatedComponent->GetComponentLocation() - OldLocation)/timeTick; //actual average velocity
+		Comp->Velocity = 2.f*Comp->Velocity - OldVelocity; //end velocity has 2* accel of avg
+		Comp->Velocity = Comp->Velocity.GetClampedToMaxSize(ISPCStore.PhysicsVolume_TerminalVelocity[Comp->SystemIndex]);
+	}
+	const FVector End = FindWaterLine(Comp, Comp->UpdatedComponent->GetComponentLocation(), OldLocation);
+	float waterTime = 0.f;
+	if (End != Comp->UpdatedComponent->GetComponentLocation())
+	{	
+		const float ActualDist = (Comp->UpdatedComponent->GetComponentLocation() - OldLocation).Size();
+		if (ActualDist > KINDA_SMALL_NUMBER)
+		{
+			waterTime = timeTick * (End - Comp->UpdatedComponent->GetComponentLocation()).Size() / ActualDist;
+			remainingTime += waterTime;
+		}
+		MoveUpdatedComponent(Comp, End - Comp->UpdatedComponent->GetComponentLocation(), Comp->UpdatedComponent->GetComponentQuat(), true);
+	}
+	if (!HasAnimRootMotion(Comp) && !Comp->CurrentRootMotion.HasOverrideVelocity() && (Comp->Velocity.Z > 2.f*SWIMBOBSPEED) && (Comp->Velocity.Z < 0.f)) //allow for falling out of water
+	{
+		Comp->Velocity.Z = SWIMBOBSPEED - Comp->Velocity.Size2D() * 0.7f; //smooth bobbing
+	}
+	if ( (remainingTime >= UCharacterMovementComponent::MIN_TICK_TIME) && (Iterations < Comp->MaxSimulationIterations) )
+	{
+		PhysSwimming(Comp, remainingTime, Iterations);
+	}
+}
+
+float UShooterUnrolledCppMovementSystem::Swim(UShooterUnrolledCppMovement* Comp, FVector Delta, FHitResult& Hit)
+{
+	FVector Start = Comp->UpdatedComponent->GetComponentLocation();
+	float airTime = 0.f;
+	const /*uniform*/ bool bMoveIgnoreFirstBlockingOverlap = !!CVars::MoveIgnoreFirstBlockingOverlap->GetInt();
+	SafeMoveUpdatedComponent(Comp, bMoveIgnoreFirstBlockingOverlap, Delta, Comp->UpdatedComponent->GetComponentQuat(), true, Hit);
+
+	if ( !IsInWater(Comp) ) //then left water
+	{
+		const FVector End = FindWaterLine(Comp, Start, Comp->UpdatedComponent->GetComponentLocation());
+		const float DesiredDist = Delta.Size();
+		if (End != Comp->UpdatedComponent->GetComponentLocation() && DesiredDist > KINDA_SMALL_NUMBER)
+		{
+			airTime = (End - Comp->UpdatedComponent->GetComponentLocation()).Size() / DesiredDist;
+			if ( ((Comp->UpdatedComponent->GetComponentLocation() - Start) | (End - Comp->UpdatedComponent->GetComponentLocation())) > 0.f )
+			{
+				airTime = 0.f;
+			}
+			SafeMoveUpdatedComponent(Comp, bMoveIgnoreFirstBlockingOverlap, End - Comp->UpdatedComponent->GetComponentLocation(), Comp->UpdatedComponent->GetComponentQuat(), true, Hit);
+		}
+	}
+	return airTime;
+}
+
+FVector UShooterUnrolledCppMovementSystem::FindWaterLine(UShooterUnrolledCppMovement* Comp, FVector InWater, FVector OutofWater)
+{
+	FVector Result = OutofWater;
+
+	TArray<FHitResult> Hits;
+	GetWorld()->LineTraceMultiByChannel(Hits, OutofWater, InWater, Comp->UpdatedComponent->GetCollisionObjectType(), FCollisionQueryParams(SCENE_QUERY_STAT(FindWaterLine), true, Comp->CharacterOwner));
+
+	for( int32 HitIdx = 0; HitIdx < Hits.Num(); HitIdx++ )
+	{
+		const FHitResult& Check = Hits[HitIdx];
+		if ( !Comp->CharacterOwner->IsOwnedBy(Check.GetActor()) && !Check.Component.Get()->IsWorldGeometry() )
+		{
+			APhysicsVolume *W = Cast<APhysicsVolume>(Check.GetActor());
+			if ( W && W->bWaterVolume )
+			{
+				FVector Dir = (InWater - OutofWater).GetSafeNormal();
+				Result = Check.Location;
+				if ( W == GetPhysicsVolume(Comp) )
+					Result += 0.1f * Dir;
+				else
+					Result -= 0.1f * Dir;
+				break;
+			}
+		}
+	}
+
+	return Result;
+}
+
+float UShooterUnrolledCppMovementSystem::ImmersionDepth(UShooterUnrolledCppMovement* Comp) const
+{
+	float depth = 0.f;
+
+	if ( Comp->CharacterOwner && IsInWater(Comp) )
+	{
+		const float CollisionHalfHeight = Comp->CharacterOwner->GetSimpleCollisionHalfHeight();
+
+		if ( (CollisionHalfHeight == 0.f) || (Comp->Buoyancy == 0.f) )
+		{
+			depth = 1.f;
+		}
+		else
+		{
+			UBrushComponent* VolumeBrushComp = GetPhysicsVolume(Comp)->GetBrushComponent();
+			FHitResult Hit(1.f);
+			if ( VolumeBrushComp )
+			{
+				const FVector TraceStart = Comp->UpdatedComponent->GetComponentLocation() + FVector(0.f,0.f,CollisionHalfHeight);
+				const FVector TraceEnd = Comp->UpdatedComponent->GetComponentLocation() - FVector(0.f,0.f,CollisionHalfHeight);
+
+				FCollisionQueryParams NewTraceParams(SCENE_QUERY_STAT(ImmersionDepth), true);
+				VolumeBrushComp->LineTraceComponent( Hit, TraceStart, TraceEnd, NewTraceParams );
+			}
+
+			depth = (Hit.Time == 1.f) ? 1.f : (1.f - Hit.Time);
+		}
+	}
+	return depth;
 }
 
 void UShooterUnrolledCppMovementSystem::StartFalling(UShooterUnrolledCppMovement* Comp, int32 Iterations, float remainingTime, float timeTick, const FVector& Delta, const FVector& subLoc)
@@ -1929,8 +3201,14 @@ void UShooterUnrolledCppMovementSystem::FindFloor(UShooterUnrolledCppMovement* C
 	{
 		if (Comp->bAlwaysCheckFloor || !bZeroDelta || Comp->bForceNextFloorCheck || Comp->bJustTeleported)
 		{
+			// A sweep we already have is as good as the cached one.
+			const bool bForceSweep = Comp->bForceNextFloorCheck || Comp->bJustTeleported || DownwardSweepResult != nullptr;
 			Comp->bForceNextFloorCheck = false;
-			ComputeFloorDist(Comp, CapsuleLocation, FloorLineTraceDist, FloorSweepTraceDist, OutFloorResult, Comp->CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius(), DownwardSweepResult);
+			if (bForceSweep || !FindCachedFloor(Comp, CapsuleLocation, OutFloorResult))
+			{
+				ComputeFloorDist(Comp, CapsuleLocation, FloorLineTraceDist, FloorSweepTraceDist, OutFloorResult, Comp->CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius(), DownwardSweepResult);
+				CacheFloor(Comp, CapsuleLocation, OutFloorResult);
+			}
 		}
 		else
 		{
@@ -1958,6 +3236,7 @@ void UShooterUnrolledCppMovementSystem::FindFloor(UShooterUnrolledCppMovement* C
 			{
 				Comp->bForceNextFloorCheck = false;
 				ComputeFloorDist(Comp, CapsuleLocation, FloorLineTraceDist, FloorSweepTraceDist, OutFloorResult, Comp->CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius(), DownwardSweepResult);
+				CacheFloor(Comp, CapsuleLocation, OutFloorResult);
 			}
 		}
 	}
@@ -2001,6 +3280,62 @@ void UShooterUnrolledCppMovementSystem::FindFloor(UShooterUnrolledCppMovement* C
 	}
 }
 
+bool UShooterUnrolledCppMovementSystem::FindCachedFloor(UShooterUnrolledCppMovement* Comp, const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult) const
+{
+	const FFloorCache& Cache = Comp->FloorCache;
+	const float Tolerance = CVarFloorCacheTolerance.GetValueOnAnyThread();
+	if (Cache.GeometryVersion != FloorCache::GeometryVersion || Tolerance <= 0.f)
+	{
+		return false;
+	}
+
+	const FVector Delta = CapsuleLocation - Cache.CapsuleLocation;
+	if (Delta.SizeSquared() > FMath::Square(Tolerance))
+	{
+		return false;
+	}
+
+	// Base movement, or the floor losing its collision, invalidates the sweep.
+	const UPrimitiveComponent* FloorComponent = Cache.Floor.HitResult.Component.Get();
+	if (FloorComponent == nullptr
+		|| !FloorComponent->IsQueryCollisionEnabled()
+		|| FloorComponent->GetComponentLocation() != Cache.FloorLocation
+		|| !FloorComponent->GetComponentQuat().Equals(Cache.FloorRotation, 0.f))
+	{
+		return false;
+	}
+
+	// The floor is flat, so moving along it keeps the hit and only shifts it along with the capsule.
+	OutFloorResult = Cache.Floor;
+	OutFloorResult.FloorDist += Delta.Z;
+	OutFloorResult.LineDist += OutFloorResult.bLineTrace ? Delta.Z : 0.f;
+	FHitResult& Hit = OutFloorResult.HitResult;
+	Hit.TraceStart += Delta;
+	Hit.TraceEnd += Delta;
+	Hit.Location += Delta;
+	Hit.ImpactPoint += FVector(Delta.X, Delta.Y, 0.f);
+
+	INC_DWORD_STAT(STAT_CharFindFloorCacheHits);
+	return true;
+}
+
+void UShooterUnrolledCppMovementSystem::CacheFloor(UShooterUnrolledCppMovement* Comp, const FVector& CapsuleLocation, const FFindFloorResult& FloorResult) const
+{
+	FFloorCache& Cache = Comp->FloorCache;
+	const UPrimitiveComponent* FloorComponent = FloorResult.HitResult.Component.Get();
+	if (FloorComponent == nullptr || !FloorResult.IsWalkableFloor() || FloorResult.HitResult.ImpactNormal.Z < FloorCache::MinNormalZ)
+	{
+		Cache.GeometryVersion = 0;
+		return;
+	}
+
+	Cache.Floor = FloorResult;
+	Cache.CapsuleLocation = CapsuleLocation;
+	Cache.FloorLocation = FloorComponent->GetComponentLocation();
+	Cache.FloorRotation = FloorComponent->GetComponentQuat();
+	Cache.GeometryVersion = FloorCache::GeometryVersion;
+}
+
 bool UShooterUnrolledCppMovementSystem::HasValidData(const UShooterUnrolledCppMovement* Comp) const
 {
 	bool bIsValid = Comp->UpdatedComponent && IsValid(Comp->CharacterOwner);
@@ -2068,9 +3403,9 @@ void UShooterUnrolledCppMovementSystem::ComputeFloorDist(UShooterUnrolledCppMove
 	}
 
 	bool bBlockingHit = false;
-	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ComputeFloorDist), false, Comp->CharacterOwner);
-	FCollisionResponseParams ResponseParam;
-	InitCollisionParams(Comp, QueryParams, ResponseParam);
+	const FPooledCollisionParams& CollisionParams = GetCollisionParams(Comp);
+	const FCollisionQueryParams& QueryParams = CollisionParams.QueryParams[BQS_ComputeFloorDist];
+	const FCollisionResponseParams& ResponseParam = CollisionParams.ResponseParams;
 	const ECollisionChannel CollisionChannel = Comp->UpdatedComponent->GetCollisionObjectType();
 
 	// Sweep test
@@ -2140,10 +3475,9 @@ void UShooterUnrolledCppMovementSystem::ComputeFloorDist(UShooterUnrolledCppMove
 		const FVector LineTraceStart = CapsuleLocation;
 		const float TraceDist = LineDistance + ShrinkHeight;
 		const FVector Down = FVector(0.f, 0.f, -TraceDist);
-		QueryParams.TraceTag = SCENE_QUERY_STAT_NAME_ONLY(FloorLineTrace);
 
 		FHitResult Hit(1.f);
-		bBlockingHit = GetWorld()->LineTraceSingleByChannel(Hit, LineTraceStart, LineTraceStart + Down, CollisionChannel, QueryParams, ResponseParam);
+		bBlockingHit = GetWorld()->LineTraceSingleByChannel(Hit, LineTraceStart, LineTraceStart + Down, CollisionChannel, CollisionParams.QueryParams[BQS_FloorLineTrace], ResponseParam);
 
 		if (bBlockingHit)
 		{
@@ -2184,6 +3518,10 @@ bool UShooterUnrolledCppMovementSystem::FloorSweepTest(
 
 	if (!Comp->bUseFlatBaseForFloorChecks)
 	{
+		if (CVarAnalyticFloor.GetValueOnAnyThread() != 0 && AnalyticFloorSweep(Comp, OutHit, Start, End, TraceChannel, CollisionShape, ResponseParam))
+		{
+			return true;
+		}
 		bBlockingHit = GetWorld()->SweepSingleByChannel(OutHit, Start, End, FQuat::Identity, TraceChannel, CollisionShape, Params, ResponseParam);
 	}
 	else
@@ -2207,6 +3545,130 @@ bool UShooterUnrolledCppMovementSystem::FloorSweepTest(
 	return bBlockingHit;
 }
 
+/** Finds the face of Primitive's collision box pointing up the most. Returns false if its collision isn't a single box. */
+static bool GetFloorBoxTopFace(const UPrimitiveComponent* Primitive, FAnalyticFloor& OutFloor)
+{
+	OutFloor.bValid = false;
+
+	const FTransform& ComponentTransform = Primitive->GetComponentTransform();
+	FVector BoxCenter, BoxExtent;
+	FQuat BoxRotation;
+	if (const UBoxComponent* Box = Cast<UBoxComponent>(Primitive))
+	{
+		BoxCenter = ComponentTransform.GetLocation();
+		BoxRotation = ComponentTransform.GetRotation();
+		BoxExtent = Box->GetScaledBoxExtent();
+	}
+	else if (const UStaticMeshComponent* Mesh = Cast<UStaticMeshComponent>(Primitive))
+	{
+		const UBodySetup* BodySetup = Mesh->GetBodySetup();
+		if (BodySetup == nullptr || BodySetup->CollisionTraceFlag == CTF_UseComplexAsSimple
+			|| BodySetup->AggGeom.BoxElems.Num() != 1 || BodySetup->AggGeom.GetElementCount() != 1)
+		{
+			return false;
+		}
+
+		const FKBoxElem& Elem = BodySetup->AggGeom.BoxElems[0];
+		const FVector Scale = ComponentTransform.GetScale3D();
+		// Mirrored boxes, and rotated boxes under non-uniform scale (sheared), aren't boxes anymore.
+		if (Scale.GetMin() <= 0.f || (!Elem.Rotation.IsNearlyZero() && !Scale.AllComponentsEqual(KINDA_SMALL_NUMBER)))
+		{
+			return false;
+		}
+		BoxCenter = ComponentTransform.TransformPosition(Elem.Center);
+		BoxRotation = ComponentTransform.GetRotation() * Elem.Rotation.Quaternion();
+		BoxExtent = 0.5f * FVector(Elem.X, Elem.Y, Elem.Z) * Scale;
+	}
+	else
+	{
+		return false;
+	}
+
+	const FVector Axes[3] = { BoxRotation.GetAxisX(), BoxRotation.GetAxisY(), BoxRotation.GetAxisZ() };
+	int32 Up = 0;
+	for (int32 Axis = 1; Axis < 3; ++Axis)
+	{
+		if (FMath::Abs(Axes[Axis].Z) > FMath::Abs(Axes[Up].Z))
+		{
+			Up = Axis;
+		}
+	}
+	OutFloor.Normal = Axes[Up] * FMath::Sign(Axes[Up].Z);
+	OutFloor.Center = BoxCenter + OutFloor.Normal * BoxExtent[Up];
+	OutFloor.AxisX = Axes[(Up + 1) % 3];
+	OutFloor.HalfX = BoxExtent[(Up + 1) % 3];
+	OutFloor.AxisY = Axes[(Up + 2) % 3];
+	OutFloor.HalfY = BoxExtent[(Up + 2) % 3];
+	OutFloor.bValid = OutFloor.Normal.Z > KINDA_SMALL_NUMBER;
+	return OutFloor.bValid;
+}
+
+bool UShooterUnrolledCppMovementSystem::AnalyticFloorSweep(UShooterUnrolledCppMovement* Comp, FHitResult& OutHit, const FVector& Start, const FVector& End, ECollisionChannel TraceChannel, const FCollisionShape& CollisionShape, const FCollisionResponseParams& ResponseParam) const
+{
+	const FHitResult& FloorHit = Comp->CurrentFloor.HitResult;
+	UPrimitiveComponent* Primitive = FloorHit.Component.Get();
+	if (Primitive == nullptr || !Comp->CurrentFloor.IsWalkableFloor() || Primitive->Mobility != EComponentMobility::Static
+		|| !CollisionShape.IsCapsule() || Start.X != End.X || Start.Y != End.Y || End.Z >= Start.Z)
+	{
+		return false;
+	}
+
+	if (!Primitive->IsQueryCollisionEnabled()
+		|| Primitive->GetCollisionResponseToChannel(TraceChannel) != ECR_Block
+		|| ResponseParam.CollisionResponse.GetResponse(Primitive->GetCollisionObjectType()) != ECR_Block)
+	{
+		return false;
+	}
+
+	FAnalyticFloor& Floor = Comp->AnalyticFloor;
+	if (Floor.Primitive.Get() != Primitive || Floor.GeometryVersion != FloorCache::GeometryVersion)
+	{
+		Floor.Primitive = Primitive;
+		Floor.GeometryVersion = FloorCache::GeometryVersion;
+		GetFloorBoxTopFace(Primitive, Floor);
+	}
+	if (!Floor.bValid)
+	{
+		return false;
+	}
+
+	// The bottom sphere of the capsule touches the face's plane once its center is Radius above it.
+	const float Radius = CollisionShape.GetCapsuleRadius();
+	const float TraceDist = Start.Z - End.Z;
+	const FVector SphereCenter = Start - FVector(0.f, 0.f, CollisionShape.GetCapsuleHalfHeight() - Radius);
+	const float Travel = (((SphereCenter - Floor.Center) | Floor.Normal) - Radius) / Floor.Normal.Z;
+	if (Travel < 0.f || Travel > TraceDist)
+	{
+		return false;
+	}
+
+	// Anywhere the capsule could also touch an edge or a side of the box, let PhysX sort it out.
+	const FVector ImpactPoint = SphereCenter - Floor.Normal * Radius - FVector(0.f, 0.f, Travel);
+	const FVector FromCenter = ImpactPoint - Floor.Center;
+	const float EdgeMargin = Radius / Floor.Normal.Z + UCharacterMovementComponent::SWEEP_EDGE_REJECT_DISTANCE;
+	if (FMath::Abs(FromCenter | Floor.AxisX) > Floor.HalfX - EdgeMargin || FMath::Abs(FromCenter | Floor.AxisY) > Floor.HalfY - EdgeMargin)
+	{
+		return false;
+	}
+
+	OutHit.Init(Start, End);
+	OutHit.bBlockingHit = true;
+	OutHit.Time = Travel / TraceDist;
+	OutHit.Distance = Travel;
+	OutHit.Location = Start - FVector(0.f, 0.f, Travel);
+	OutHit.ImpactPoint = ImpactPoint;
+	OutHit.Normal = Floor.Normal;
+	OutHit.ImpactNormal = Floor.Normal;
+	OutHit.Component = Primitive;
+	OutHit.Actor = Primitive->GetOwner();
+	OutHit.PhysMaterial = FloorHit.PhysMaterial;
+	OutHit.Item = FloorHit.Item;
+	OutHit.FaceIndex = FloorHit.FaceIndex;
+
+	INC_DWORD_STAT(STAT_CharAnalyticFloorSweeps);
+	return true;
+}
+
 void UShooterUnrolledCppMovementSystem::RevertMove(UShooterUnrolledCppMovement* Comp, const FVector& OldLocation, UPrimitiveComponent* OldBase, const FVector& PreviousBaseLocation, const FFindFloorResult& OldFloor, bool bFailMove)
 {
 	//UE_LOG(LogUnrolledCharacterMovement, Log, TEXT("RevertMove from %f %f %f to %f %f %f"), CharacterOwner->Location.X, CharacterOwner->Location.Y, CharacterOwner->Location.Z, OldLocation.X, OldLocation.Y, OldLocation.Z);
@@ -2274,23 +3736,19 @@ void UShooterUnrolledCppMovementSystem::OnCharacterStuckInGeometry(UShooterUnrol
 		if ((RealTimeSeconds - Comp->LastStuckWarningTime) >= StuckWarningPeriod)
 		{
 			Comp->LastStuckWarningTime = RealTimeSeconds;
-			if (Hit == nullptr)
+			const bool bQueued = FMovementEventQueue::TryQueue(EMovementEventType::StuckInGeometry, Comp, Comp->SystemIndex, Comp->CharacterOwner, [&](FMovementEvent& Event)
 			{
-				UE_LOG(LogUnrolledCharacterMovement, Log, TEXT("%s is stuck and failed to move! (%d other events since notify)"), *Comp->CharacterOwner->GetName(), Comp->StuckWarningCountSinceNotify);
-			}
-			else
+				Event.bHasHit = Hit != nullptr;
+				if (Hit)
+				{
+					Event.Hit = *Hit;
+				}
+				Event.Velocity = Comp->Velocity;
+				Event.Count = Comp->StuckWarningCountSinceNotify;
+			});
+			if (!bQueued)
 			{
-				UE_LOG(LogUnrolledCharacterMovement, Log, TEXT("%s is stuck and failed to move! Velocity: X=%3.2f Y=%3.2f Z=%3.2f Location: X=%3.2f Y=%3.2f Z=%3.2f Normal: X=%3.2f Y=%3.2f Z=%3.2f PenetrationDepth:%.3f Actor:%s Component:%s BoneName:%s (%d other events since notify)"),
-					   *GetNameSafe(Comp->CharacterOwner),
-					   Comp->Velocity.X, Comp->Velocity.Y, Comp->Velocity.Z,
-					   Hit->Location.X, Hit->Location.Y, Hit->Location.Z,
-					   Hit->Normal.X, Hit->Normal.Y, Hit->Normal.Z,
-					   Hit->PenetrationDepth,
-					   *GetNameSafe(Hit->GetActor()),
-					   *GetNameSafe(Hit->GetComponent()),
-					   Hit->BoneName.IsValid() ? *Hit->BoneName.ToString() : TEXT("None"),
-					   Comp->StuckWarningCountSinceNotify
-					   );
+				LogStuckInGeometry(Comp, Hit, Comp->Velocity, Comp->StuckWarningCountSinceNotify);
 			}
 			Comp->StuckWarningCountSinceNotify = 0;
 		}
@@ -2304,6 +3762,28 @@ void UShooterUnrolledCppMovementSystem::OnCharacterStuckInGeometry(UShooterUnrol
 	Comp->bJustTeleported = true;
 }
 
+void UShooterUnrolledCppMovementSystem::LogStuckInGeometry(UShooterUnrolledCppMovement* Comp, const FHitResult* Hit, const FVector& Velocity, int32 EventsSinceNotify) const
+{
+	if (Hit == nullptr)
+	{
+		UE_LOG(LogUnrolledCharacterMovement, Log, TEXT("%s is stuck and failed to move! (%d other events since notify)"), *Comp->CharacterOwner->GetName(), EventsSinceNotify);
+	}
+	else
+	{
+		UE_LOG(LogUnrolledCharacterMovement, Log, TEXT("%s is stuck and failed to move! Velocity: X=%3.2f Y=%3.2f Z=%3.2f Location: X=%3.2f Y=%3.2f Z=%3.2f Normal: X=%3.2f Y=%3.2f Z=%3.2f PenetrationDepth:%.3f Actor:%s Component:%s BoneName:%s (%d other events since notify)"),
+			   *GetNameSafe(Comp->CharacterOwner),
+			   Velocity.X, Velocity.Y, Velocity.Z,
+			   Hit->Location.X, Hit->Location.Y, Hit->Location.Z,
+			   Hit->Normal.X, Hit->Normal.Y, Hit->Normal.Z,
+			   Hit->PenetrationDepth,
+			   *GetNameSafe(Hit->GetActor()),
+			   *GetNameSafe(Hit->GetComponent()),
+			   Hit->BoneName.IsValid() ? *Hit->BoneName.ToString() : TEXT("None"),
+			   EventsSinceNotify
+			   );
+	}
+}
+
 void UShooterUnrolledCppMovementSystem::MoveAlongFloor(UShooterUnrolledCppMovement* Comp, const FVector& InVelocity, float DeltaSeconds, UCharacterMovementComponent::FStepDownResult* OutStepDownResult)
 {
 	if (!Comp->CurrentFloor.IsWalkableFloor())
@@ -2520,6 +4000,11 @@ bool UShooterUnrolledCppMovementSystem::CanStepUp(UShooterUnrolledCppMovement* C
 
 bool UShooterUnrolledCppMovementSystem::StepUp(UShooterUnrolledCppMovement* Comp, const FVector& GravDir, const FVector& Delta, const FHitResult &InHit, UCharacterMovementComponent::FStepDownResult* OutStepDownResult)
 {
+	if (!IsInGameThread())
+	{
+		return RunOnGameThread([&]() { return StepUp(Comp, GravDir, Delta, InHit, OutStepDownResult); });
+	}
+
 	SCOPE_CYCLE_COUNTER(STAT_CharStepUp);
 
 	if (!CanStepUp(Comp, InHit) || Comp->MaxStepHeight <= 0.f)
@@ -2862,7 +4347,8 @@ void UShooterUnrolledCppMovementSystem::SetBase( UShooterUnrolledCppMovement* Co
 
 	if (Comp->CharacterOwner && !Comp->bIsNavWalkingOnServer)
 	{
-		Comp->CharacterOwner->SetBase(NewBase, NewBase ? BoneName : NAME_None, bNotifyActor);
+		// Not deferred: the rest of the move reads the new base through GetMovementBase().
+		RunOnGameThread([&]() { Comp->CharacterOwner->SetBase(NewBase, NewBase ? BoneName : NAME_None, bNotifyActor); });
 	}
 }
 
@@ -2976,6 +4462,11 @@ bool UShooterUnrolledCppMovementSystem::CanCrouchInCurrentState(UShooterUnrolled
 
 void UShooterUnrolledCppMovementSystem::Crouch(UShooterUnrolledCppMovement* Comp, bool bClientSimulation)
 {
+	if (!IsInGameThread())
+	{
+		return RunOnGameThread([&]() { return Crouch(Comp, bClientSimulation); });
+	}
+
 	if (!HasValidData(Comp))
 	{
 		return;
@@ -3023,11 +4514,13 @@ void UShooterUnrolledCppMovementSystem::Crouch(UShooterUnrolledCppMovement* Comp
 		// Crouching to a larger height? (this is rare)
 		if (ClampedCrouchedHalfHeight > OldUnscaledHalfHeight)
 		{
-			FCollisionQueryParams CapsuleParams(SCENE_QUERY_STAT(CrouchTrace), false, Comp->CharacterOwner);
-			FCollisionResponseParams ResponseParam;
-			InitCollisionParams(Comp, CapsuleParams, ResponseParam);
-			const bool bEncroached = GetWorld()->OverlapBlockingTestByChannel(Comp->UpdatedComponent->GetComponentLocation() - FVector(0.f,0.f,ScaledHalfHeightAdjust), FQuat::Identity,
-				Comp->UpdatedComponent->GetCollisionObjectType(), Comp->GetPawnCapsuleCollisionShape(UCharacterMovementComponent::EShrinkCapsuleExtent::SHRINK_None), CapsuleParams, ResponseParam);
+			const FPooledCollisionParams& CollisionParams = GetCollisionParams(Comp);
+			const FCollisionQueryParams& CapsuleParams = CollisionParams.QueryParams[BQS_CrouchTrace];
+			const FCollisionResponseParams& ResponseParam = CollisionParams.ResponseParams;
+			const FVector CrouchedLocation = Comp->UpdatedComponent->GetComponentLocation() - FVector(0.f,0.f,ScaledHalfHeightAdjust);
+			const FCollisionShape CrouchedCapsuleShape = Comp->GetPawnCapsuleCollisionShape(UCharacterMovementComponent::EShrinkCapsuleExtent::SHRINK_None);
+			const bool bEncroached = GetWorld()->OverlapBlockingTestByChannel(CrouchedLocation, FQuat::Identity,
+				Comp->UpdatedComponent->GetCollisionObjectType(), CrouchedCapsuleShape, CapsuleParams, ResponseParam) || OverlapBots(Comp, CrouchedLocation, CrouchedCapsuleShape);
 
 			// If encroached, cancel
 			if( bEncroached )
@@ -3080,6 +4573,11 @@ void UShooterUnrolledCppMovementSystem::Crouch(UShooterUnrolledCppMovement* Comp
 
 void UShooterUnrolledCppMovementSystem::UnCrouch(UShooterUnrolledCppMovement* Comp, bool bClientSimulation)
 {
+	if (!IsInGameThread())
+	{
+		return RunOnGameThread([&]() { return UnCrouch(Comp, bClientSimulation); });
+	}
+
 	if (!HasValidData(Comp))
 	{
 		return;
@@ -3114,9 +4612,9 @@ void UShooterUnrolledCppMovementSystem::UnCrouch(UShooterUnrolledCppMovement* Co
 	{
 		// Try to stay in place and see if the larger capsule fits. We use a slightly taller capsule to avoid penetration.
 		const float SweepInflation = KINDA_SMALL_NUMBER * 10.f;
-		FCollisionQueryParams CapsuleParams(SCENE_QUERY_STAT(CrouchTrace), false, Comp->CharacterOwner);
-		FCollisionResponseParams ResponseParam;
-		InitCollisionParams(Comp, CapsuleParams, ResponseParam);
+		const FPooledCollisionParams& CollisionParams = GetCollisionParams(Comp);
+		const FCollisionQueryParams& CapsuleParams = CollisionParams.QueryParams[BQS_CrouchTrace];
+		const FCollisionResponseParams& ResponseParam = CollisionParams.ResponseParams;
 
 		// Compensate for the difference between current capsule size and standing size
 		const FCollisionShape StandingCapsuleShape = Comp->GetPawnCapsuleCollisionShape(UCharacterMovementComponent::EShrinkCapsuleExtent::SHRINK_HeightCustom, -SweepInflation - ScaledHalfHeightAdjust); // Shrink by negative amount, so actually grow it.
@@ -3126,7 +4624,7 @@ void UShooterUnrolledCppMovementSystem::UnCrouch(UShooterUnrolledCppMovement* Co
 		if (!Comp->bCrouchMaintainsBaseLocation)
 		{
 			// Expand in place
-			bEncroached = GetWorld()->OverlapBlockingTestByChannel(PawnLocation, FQuat::Identity, CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam);
+			bEncroached = GetWorld()->OverlapBlockingTestByChannel(PawnLocation, FQuat::Identity, CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam) || OverlapBots(Comp, PawnLocation, StandingCapsuleShape);
 		
 			if (bEncroached)
 			{
@@ -3152,7 +4650,7 @@ void UShooterUnrolledCppMovementSystem::UnCrouch(UShooterUnrolledCppMovement* Co
 						// Compute where the base of the sweep ended up, and see if we can stand there
 						const float DistanceToBase = (Hit.Time * TraceDist) + ShortCapsuleShape.Capsule.HalfHeight;
 						const FVector NewLoc = FVector(PawnLocation.X, PawnLocation.Y, PawnLocation.Z - DistanceToBase + PawnHalfHeight + SweepInflation + UCharacterMovementComponent::MIN_FLOOR_DIST / 2.f);
-						bEncroached = GetWorld()->OverlapBlockingTestByChannel(NewLoc, FQuat::Identity, CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam);
+						bEncroached = GetWorld()->OverlapBlockingTestByChannel(NewLoc, FQuat::Identity, CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam) || OverlapBots(Comp, NewLoc, StandingCapsuleShape);
 						if (!bEncroached)
 						{
 							// Intentionally not using MoveUpdatedComponent, where a horizontal plane constraint would prevent the base of the capsule from staying at the same spot.
@@ -3166,7 +4664,7 @@ void UShooterUnrolledCppMovementSystem::UnCrouch(UShooterUnrolledCppMovement* Co
 		{
 			// Expand while keeping base location the same.
 			FVector StandingLocation = PawnLocation + FVector(0.f, 0.f, StandingCapsuleShape.GetCapsuleHalfHeight() - CurrentCrouchedHalfHeight);
-			bEncroached = GetWorld()->OverlapBlockingTestByChannel(StandingLocation, FQuat::Identity, CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam);
+			bEncroached = GetWorld()->OverlapBlockingTestByChannel(StandingLocation, FQuat::Identity, CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam) || OverlapBots(Comp, StandingLocation, StandingCapsuleShape);
 
 			if (bEncroached)
 			{
@@ -3177,7 +4675,7 @@ void UShooterUnrolledCppMovementSystem::UnCrouch(UShooterUnrolledCppMovement* Co
 					if (Comp->CurrentFloor.bBlockingHit && Comp->CurrentFloor.FloorDist > MinFloorDist)
 					{
 						StandingLocation.Z -= Comp->CurrentFloor.FloorDist - MinFloorDist;
-						bEncroached = GetWorld()->OverlapBlockingTestByChannel(StandingLocation, FQuat::Identity, CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam);
+						bEncroached = GetWorld()->OverlapBlockingTestByChannel(StandingLocation, FQuat::Identity, CollisionChannel, StandingCapsuleShape, CapsuleParams, ResponseParam) || OverlapBots(Comp, StandingLocation, StandingCapsuleShape);
 					}
 				}				
 			}
@@ -3231,6 +4729,11 @@ void UShooterUnrolledCppMovementSystem::UnCrouch(UShooterUnrolledCppMovement* Co
 // @todo UE4 - handle lift moving up and down through encroachment
 void UShooterUnrolledCppMovementSystem::UpdateBasedMovement(UShooterUnrolledCppMovement* Comp, float DeltaSeconds)
 {
+	if (!IsInGameThread())
+	{
+		return RunOnGameThread([&]() { return UpdateBasedMovement(Comp, DeltaSeconds); });
+	}
+
 	if (!HasValidData(Comp))
 	{
 		return;
@@ -3501,16 +5004,75 @@ bool UShooterUnrolledCppMovementSystem::ResolvePenetration(UShooterUnrolledCppMo
 
 bool UShooterUnrolledCppMovementSystem::MoveUpdatedComponent(UShooterUnrolledCppMovement* Comp, const FVector& Delta, const FQuat& NewRotation, bool bSweep, FHitResult* OutHit, ETeleportType Teleport)
 {
+	if (!IsInGameThread())
+	{
+		return RunOnGameThread([&]() { return MoveUpdatedComponent(Comp, Delta, NewRotation, bSweep, OutHit, Teleport); });
+	}
+
 	if (Comp->UpdatedComponent)
 	{
 		const FVector NewDelta = ConstrainDirectionToPlane(Comp, Delta);
+		const bool bInBroadphase = BotBroadphase.Contains(Comp->SystemIndex) && Comp->BotBroadphase.Primitive.IsValid();
+		if (bInBroadphase)
+		{
+			BotBroadphase.Update(Comp->SystemIndex, Comp->UpdatedComponent->GetComponentLocation());
+			FBotContact Contact;
+			if (bSweep && !NewDelta.IsZero() && BotBroadphase.SweepCapsule(Comp->SystemIndex, NewDelta, Contact))
+			{
+				return MoveUpdatedComponentToBot(Comp, NewDelta, NewRotation, OutHit, Teleport, Contact);
+			}
+		}
+
 		// TODO ISPC: foreach_active
-		return Comp->UpdatedComponent->MoveComponent(NewDelta, NewRotation, bSweep, OutHit, Comp->MoveComponentFlags, Teleport);
+		const bool bMoved = Comp->UpdatedComponent->MoveComponent(NewDelta, NewRotation, bSweep, OutHit, Comp->MoveComponentFlags, Teleport);
+		if (bInBroadphase)
+		{
+			BotBroadphase.Update(Comp->SystemIndex, Comp->UpdatedComponent->GetComponentLocation());
+		}
+		return bMoved;
 	}
 
 	return false;
 }
 
+bool UShooterUnrolledCppMovementSystem::MoveUpdatedComponentToBot(UShooterUnrolledCppMovement* Comp, const FVector& Delta, const FQuat& NewRotation, FHitResult* OutHit, ETeleportType Teleport, const FBotContact& Contact)
+{
+	INC_DWORD_STAT(STAT_CharBotContacts);
+
+	// Stop short of the other capsule, like MoveComponent() pulls back from its hits.
+	const float DeltaSize = Delta.Size();
+	const float MoveTime = FMath::Max(0.f, Contact.Time - 0.1f / DeltaSize);
+	const FVector Start = Comp->UpdatedComponent->GetComponentLocation();
+
+	FHitResult LocalHit;
+	FHitResult& Hit = OutHit ? *OutHit : LocalHit;
+	const bool bMoved = Comp->UpdatedComponent->MoveComponent(Delta * MoveTime, NewRotation, true, &Hit, Comp->MoveComponentFlags, Teleport);
+	BotBroadphase.Update(Comp->SystemIndex, Comp->UpdatedComponent->GetComponentLocation());
+
+	if (Hit.bBlockingHit)
+	{
+		// The world got in the way first. Callers expect the time relative to the whole move.
+		Hit.Time *= MoveTime;
+		Hit.TraceEnd = Hit.TraceStart + Delta;
+		return bMoved;
+	}
+
+	const UShooterUnrolledCppMovement* Other = Components[Contact.Index];
+	Hit.Init(Start, Start + Delta);
+	Hit.bBlockingHit = true;
+	Hit.bStartPenetrating = Contact.Time == 0.f && Contact.PenetrationDepth > 0.f;
+	Hit.PenetrationDepth = Hit.bStartPenetrating ? Contact.PenetrationDepth : 0.f;
+	Hit.Time = MoveTime;
+	Hit.Distance = DeltaSize * MoveTime;
+	Hit.Location = Comp->UpdatedComponent->GetComponentLocation();
+	Hit.ImpactPoint = Contact.ImpactPoint;
+	Hit.Normal = Contact.Normal;
+	Hit.ImpactNormal = Contact.Normal;
+	Hit.Actor = Other->CharacterOwner;
+	Hit.Component = Other->UpdatedPrimitive;
+	return bMoved;
+}
+
 FVector UShooterUnrolledCppMovementSystem::ConstrainDirectionToPlane(UShooterUnrolledCppMovement* Comp, FVector Direction) const
 {
 	if (Comp->bConstrainToPlane)
@@ -3551,11 +5113,31 @@ void UShooterUnrolledCppMovementSystem::SnapUpdatedComponentToPlane(UShooterUnro
 
 bool UShooterUnrolledCppMovementSystem::OverlapTest(UShooterUnrolledCppMovement* Comp, const FVector& Location, const FQuat& RotationQuat, const ECollisionChannel CollisionChannel, const FCollisionShape& CollisionShape, const AActor* IgnoreActor) const
 {
+	if (IgnoreActor == Comp->CharacterOwner)
+	{
+		const FPooledCollisionParams& CollisionParams = GetCollisionParams(Comp);
+		return GetWorld()->OverlapBlockingTestByChannel(Location, RotationQuat, CollisionChannel, CollisionShape, CollisionParams.QueryParams[BQS_MovementOverlapTest], CollisionParams.ResponseParams)
+			|| OverlapBots(Comp, Location, CollisionShape);
+	}
 	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(MovementOverlapTest), false, IgnoreActor);
 	FCollisionResponseParams ResponseParam;
-	// TODO ISPC: Fold these two calls together?
 	InitCollisionParams(Comp, QueryParams, ResponseParam);
-	return GetWorld()->OverlapBlockingTestByChannel(Location, RotationQuat, CollisionChannel, CollisionShape, QueryParams, ResponseParam);
+	return GetWorld()->OverlapBlockingTestByChannel(Location, RotationQuat, CollisionChannel, CollisionShape, QueryParams, ResponseParam)
+		|| OverlapBots(Comp, Location, CollisionShape);
+}
+
+bool UShooterUnrolledCppMovementSystem::OverlapBots(UShooterUnrolledCppMovement* Comp, const FVector& Location, const FCollisionShape& CollisionShape) const
+{
+	if (!CollisionShape.IsCapsule() || !BotBroadphase.Contains(Comp->SystemIndex) || !Comp->BotBroadphase.Primitive.IsValid())
+	{
+		return false;
+	}
+	if (!IsInGameThread())
+	{
+		// The grid is kept up to date by moves marshalled to the game thread.
+		return RunOnGameThread([&]() { return OverlapBots(Comp, Location, CollisionShape); });
+	}
+	return BotBroadphase.OverlapCapsule(Comp->SystemIndex, Location, CollisionShape.GetCapsuleRadius(), CollisionShape.GetCapsuleHalfHeight());
 }
 
 bool UShooterUnrolledCppMovementSystem::IsExceedingMaxSpeed(UShooterUnrolledCppMovement* Comp, float MaxSpeed) const
@@ -3759,7 +5341,10 @@ void UShooterUnrolledCppMovementSystem::NotifyJumpApex(UShooterUnrolledCppMoveme
 	if( Comp->CharacterOwner )
 	{
 		// TODO ISPC: foreach_active
-		Comp->CharacterOwner->NotifyJumpApex();
+		if (!FMovementEventQueue::TryQueue(EMovementEventType::JumpApex, Comp, Comp->SystemIndex, Comp->CharacterOwner, [](FMovementEvent&) {}))
+		{
+			RunOnGameThread([&]() { Comp->CharacterOwner->NotifyJumpApex(); });
+		}
 	}
 }
 
@@ -3773,7 +5358,7 @@ FVector UShooterUnrolledCppMovementSystem::NewFallVelocity(UShooterUnrolledCppMo
 		Result += Gravity * DeltaTime;
 
 		const FVector GravityDir = Gravity.GetSafeNormal();
-		const float TerminalLimit = FMath::Abs(GetPhysicsVolume(Comp)->TerminalVelocity);
+		const float TerminalLimit = FMath::Abs(ISPCStore.PhysicsVolume_TerminalVelocity[Comp->SystemIndex]);
 
 		// Don't exceed terminal velocity.
 		if ((Result | GravityDir) > TerminalLimit)
@@ -3792,7 +5377,7 @@ void UShooterUnrolledCppMovementSystem::StopActiveMovement(UShooterUnrolledCppMo
 		if (Comp->PathFollowingComp.IsValid() && Comp->bStopMovementAbortPaths)
 		{
 			// TODO ISPC: foreach_active
-			Comp->PathFollowingComp->AbortMove(*this, FPathFollowingResultFlags::MovementStop);
+			RunOnGameThread([&]() { Comp->PathFollowingComp->AbortMove(*this, FPathFollowingResultFlags::MovementStop); });
 		}
 	}
 
@@ -3807,7 +5392,14 @@ void UShooterUnrolledCppMovementSystem::ProcessLanded(UShooterUnrolledCppMovemen
 
 	if( Comp->CharacterOwner && Comp->CharacterOwner->ShouldNotifyLanded(Hit) )
 	{
-		Comp->CharacterOwner->Landed(Hit);
+		const bool bQueued = FMovementEventQueue::TryQueue(EMovementEventType::Landed, Comp, Comp->SystemIndex, Comp->CharacterOwner, [&](FMovementEvent& Event)
+		{
+			Event.Hit = Hit;
+		});
+		if (!bQueued)
+		{
+			ParallelMovement::DeferOrRun([CharacterOwner = Comp->CharacterOwner, Hit]() { CharacterOwner->Landed(Hit); });
+		}
 	}
 	if( IsFalling(Comp) )
 	{
@@ -3833,7 +5425,7 @@ void UShooterUnrolledCppMovementSystem::ProcessLanded(UShooterUnrolledCppMovemen
 	// TODO ISPC: foreach_active?
 	if (Comp->PathFollowingComp.IsValid())
 	{
-		Comp->PathFollowingComp->OnLanded();
+		RunOnGameThread([&]() { Comp->PathFollowingComp->OnLanded(); });
 	}
 
 	StartNewPhysics(Comp, remainingTime, Iterations);
@@ -3869,6 +5461,31 @@ void UShooterUnrolledCppMovementSystem::SetPostLandedPhysics(UShooterUnrolledCpp
 }
 
 void UShooterUnrolledCppMovementSystem::HandleImpact(UShooterUnrolledCppMovement* Comp, const FHitResult& Impact, float TimeSlice, const FVector& MoveDelta)
+{
+	// Capture what the impact forces need now, the bot keeps moving before a queued event is delivered.
+	const FVector ForceAccel = Comp->bEnablePhysicsInteraction ? Comp->Acceleration + (IsFalling(Comp) ? FVector(0.f, 0.f, GetGravityZ(Comp)) : FVector::ZeroVector) : FVector::ZeroVector;
+	const bool bQueued = FMovementEventQueue::TryQueue(EMovementEventType::Impact, Comp, Comp->SystemIndex, Comp->CharacterOwner, [&](FMovementEvent& Event)
+	{
+		Event.Hit = Impact;
+		Event.Time = TimeSlice;
+		Event.Delta = MoveDelta;
+		Event.Acceleration = ForceAccel;
+		Event.Velocity = Comp->Velocity;
+	});
+	if (bQueued)
+	{
+		return;
+	}
+
+	if (!IsInGameThread())
+	{
+		const FVector ImpactVelocity = Comp->Velocity;
+		return RunOnGameThread([&]() { return DeliverImpact(Comp, Impact, TimeSlice, MoveDelta, ForceAccel, ImpactVelocity); });
+	}
+	DeliverImpact(Comp, Impact, TimeSlice, MoveDelta, ForceAccel, Comp->Velocity);
+}
+
+void UShooterUnrolledCppMovementSystem::DeliverImpact(UShooterUnrolledCppMovement* Comp, const FHitResult& Impact, float TimeSlice, const FVector& MoveDelta, const FVector& ImpactAcceleration, const FVector& ImpactVelocity)
 {
 	SCOPE_CYCLE_COUNTER(STAT_CharHandleImpact);
 
@@ -3891,8 +5508,7 @@ void UShooterUnrolledCppMovementSystem::HandleImpact(UShooterUnrolledCppMovement
 
 	if (Comp->bEnablePhysicsInteraction)
 	{
-		const FVector ForceAccel = Comp->Acceleration + (IsFalling(Comp) ? FVector(0.f, 0.f, GetGravityZ(Comp)) : FVector::ZeroVector);
-		ApplyImpactPhysicsForces(Comp, Impact, ForceAccel, Comp->Velocity);
+		ApplyImpactPhysicsForces(Comp, Impact, ImpactAcceleration, ImpactVelocity);
 	}
 }
 
@@ -3906,6 +5522,11 @@ void UShooterUnrolledCppMovementSystem::UpdateComponentVelocity(UShooterUnrolled
 
 void UShooterUnrolledCppMovementSystem::ApplyImpactPhysicsForces(UShooterUnrolledCppMovement* Comp, const FHitResult& Impact, const FVector& ImpactAcceleration, const FVector& ImpactVelocity)
 {
+	if (!IsInGameThread())
+	{
+		return RunOnGameThread([&]() { return ApplyImpactPhysicsForces(Comp, Impact, ImpactAcceleration, ImpactVelocity); });
+	}
+
 	if (Comp->bEnablePhysicsInteraction && Impact.bBlockingHit )
 	{
 		if (UPrimitiveComponent* ImpactComponent = Impact.GetComponent())
@@ -3973,16 +5594,76 @@ void UShooterUnrolledCppMovementSystem::ApplyImpactPhysicsForces(UShooterUnrolle
 
 bool UShooterUnrolledCppMovementSystem::FindNavFloor(UShooterUnrolledCppMovement* Comp, const FVector& TestLocation, FNavLocation& NavFloorLocation) const
 {
-#if 1	// TODO ISPC
-	unimplemented();
-	return false;
-#else
 	const ANavigationData* NavData = Comp->GetNavData();
 	if (NavData == nullptr)
 	{
 		return false;
 	}
 
+	return NavData->ProjectPoint(TestLocation, NavFloorLocation, GetNavFloorExtent(Comp));
+}
+
+void UShooterUnrolledCppMovementSystem::FindNavFloors(TArray<FNavWalkingMove>& Moves) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_CharNavProjectPoint);
+
+	// One batch per navigation data and query extent. Bots of one class share their agent properties, so this is
+	// normally a single ProjectPoint batch per navmesh.
+	struct FProjectionBatch
+	{
+		const ANavigationData* NavData;
+		FVector Extent;
+		TArray<FNavigationProjectionWork> Workload;
+		TArray<int32> MoveIndices;
+	};
+	TArray<FProjectionBatch, TInlineAllocator<4>> Batches;
+
+	for (int32 MoveIndex = 0; MoveIndex < Moves.Num(); ++MoveIndex)
+	{
+		FNavWalkingMove& Move = Moves[MoveIndex];
+		if (!Move.bNeedsProjection)
+		{
+			continue;
+		}
+
+		const ANavigationData* NavData = Move.Comp->GetNavData();
+		if (NavData == nullptr)
+		{
+			Move.bHasNavigationData = false;
+			continue;
+		}
+
+		const FVector Extent = GetNavFloorExtent(Move.Comp);
+		FProjectionBatch* Batch = Batches.FindByPredicate([NavData, &Extent](const FProjectionBatch& Other)
+		{
+			return Other.NavData == NavData && Other.Extent == Extent;
+		});
+		if (Batch == nullptr)
+		{
+			Batch = &Batches[Batches.AddDefaulted()];
+			Batch->NavData = NavData;
+			Batch->Extent = Extent;
+		}
+		Batch->Workload.Emplace(Move.AdjustedDest);
+		Batch->MoveIndices.Add(MoveIndex);
+	}
+
+	for (FProjectionBatch& Batch : Batches)
+	{
+		INC_DWORD_STAT_BY(STAT_CharacterMovementNavProjections, Batch.Workload.Num());
+		Batch.NavData->BatchProjectPoints(Batch.Workload, Batch.Extent);
+		for (int32 WorkIndex = 0; WorkIndex < Batch.Workload.Num(); ++WorkIndex)
+		{
+			const FNavigationProjectionWork& Work = Batch.Workload[WorkIndex];
+			FNavWalkingMove& Move = Moves[Batch.MoveIndices[WorkIndex]];
+			Move.bHasNavigationData = Work.bResult;
+			Move.DestNavLocation = Work.OutLocation;
+		}
+	}
+}
+
+FVector UShooterUnrolledCppMovementSystem::GetNavFloorExtent(UShooterUnrolledCppMovement* Comp) const
+{
 	INavAgentInterface* MyNavAgent = CastChecked<INavAgentInterface>(Comp->CharacterOwner);
 	float SearchRadius = 0.0f;
 	float SearchHeight = 100.0f;
@@ -3993,8 +5674,7 @@ bool UShooterUnrolledCppMovementSystem::FindNavFloor(UShooterUnrolledCppMovement
 		SearchHeight = AgentProps.AgentHeight * AgentProps.NavWalkingSearchHeightScale;
 	}
 
-	return NavData->ProjectPoint(TestLocation, NavFloorLocation, FVector(SearchRadius, SearchRadius, SearchHeight));
-#endif
+	return FVector(SearchRadius, SearchRadius, SearchHeight);
 }
 
 float UShooterUnrolledCppMovementSystem::SlideAlongSurface(UShooterUnrolledCppMovement* Comp, const FVector& Delta, float Time, const FVector& InNormal, FHitResult& Hit, bool bHandleImpact)
@@ -2,12 +2,15 @@
 
 #include "Engine/NetworkObjectList.h"
 #include "Engine/World.h"
+#include "Misc/ScopeExit.h"
 
 // @todo this is here only due to circular dependency to AIModule. To be removed
 #include "Navigation/PathFollowingComponent.h"
 #include "AI/Navigation/RecastNavMesh.h"
 #include "AI/Navigation/AvoidanceManager.h"
 #include "Components/BrushComponent.h"
+#include "Components/BoxComponent.h"
+#include "PhysicsEngine/BodySetup.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogUnrolledCharacterMovement, Log, All);
 DEFINE_LOG_CATEGORY_STATIC(LogUnrolledNavMeshMovement, Log, All);
@@ -32,6 +35,8 @@ DECLARE_CYCLE_STAT(TEXT("UnrCpp Char SmoothClientPosition_Visual"), STAT_Charact
 DECLARE_CYCLE_STAT(TEXT("UnrCpp Char Physics Interation"), STAT_CharPhysicsInteraction, STATGROUP_UnrCppChar);
 DECLARE_CYCLE_STAT(TEXT("UnrCpp Char StepUp"), STAT_CharStepUp, STATGROUP_UnrCppChar);
 DECLARE_CYCLE_STAT(TEXT("UnrCpp Char FindFloor"), STAT_CharFindFloor, STATGROUP_UnrCppChar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("UnrCpp Char FindFloor Cache Hits"), STAT_CharFindFloorCacheHits, STATGROUP_UnrCppChar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("UnrCpp Char Analytic Floor Sweeps"), STAT_CharAnalyticFloorSweeps, STATGROUP_UnrCppChar);
 DECLARE_CYCLE_STAT(TEXT("UnrCpp Char AdjustFloorHeight"), STAT_CharAdjustFloorHeight, STATGROUP_UnrCppChar);
 DECLARE_CYCLE_STAT(TEXT("UnrCpp Char Update Acceleration"), STAT_CharUpdateAcceleration, STATGROUP_UnrCppChar);
 DECLARE_CYCLE_STAT(TEXT("UnrCpp Char MoveUpdateDelegate"), STAT_CharMoveUpdateDelegate, STATGROUP_UnrCppChar);
@@ -40,40 +45,294 @@ DECLARE_CYCLE_STAT(TEXT("UnrCpp Char PhysFalling"), STAT_CharPhysFalling, STATGR
 DECLARE_CYCLE_STAT(TEXT("UnrCpp Char PhysNavWalking"), STAT_CharPhysNavWalking, STATGROUP_UnrCppChar);
 DECLARE_CYCLE_STAT(TEXT("UnrCpp Char NavProjectPoint"), STAT_CharNavProjectPoint, STATGROUP_UnrCppChar);
 DECLARE_CYCLE_STAT(TEXT("UnrCpp Char NavProjectLocation"), STAT_CharNavProjectLocation, STATGROUP_UnrCppChar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("UnrCpp Char NavWalking Projections"), STAT_CharacterMovementNavProjections, STATGROUP_UnrCppChar);
 DECLARE_CYCLE_STAT(TEXT("UnrCpp Char ProcessLanded"), STAT_CharProcessLanded, STATGROUP_UnrCppChar);
 DECLARE_CYCLE_STAT(TEXT("UnrCpp Char HandleImpact"), STAT_CharHandleImpact, STATGROUP_UnrCppChar);
+DECLARE_CYCLE_STAT(TEXT("UnrCpp Char ISPC Tick"), STAT_CharacterMovementISPCTick, STATGROUP_UnrCppChar);
+DECLARE_CYCLE_STAT(TEXT("UnrCpp Char ISPC Gather"), STAT_CharacterMovementISPCGather, STATGROUP_UnrCppChar);
+DECLARE_CYCLE_STAT(TEXT("UnrCpp Char ISPC Kernel"), STAT_CharacterMovementISPCKernel, STATGROUP_UnrCppChar);
+DECLARE_CYCLE_STAT(TEXT("UnrCpp Char ISPC Scatter"), STAT_CharacterMovementISPCScatter, STATGROUP_UnrCppChar);
+DECLARE_CYCLE_STAT(TEXT("UnrCpp Char ISPC Bucketing"), STAT_CharacterMovementISPCBucketing, STATGROUP_UnrCppChar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("UnrCpp Char ISPC Buckets"), STAT_CharacterMovementISPCBuckets, STATGROUP_UnrCppChar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("UnrCpp Char ISPC Requeued"), STAT_CharacterMovementISPCRequeued, STATGROUP_UnrCppChar);
+DECLARE_CYCLE_STAT(TEXT("UnrCpp Char ISPC Scalar Fallback"), STAT_CharacterMovementISPCScalarFallback, STATGROUP_UnrCppChar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("UnrCpp Char ISPC Vector Bots"), STAT_CharacterMovementISPCVectorBots, STATGROUP_UnrCppChar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("UnrCpp Char ISPC Scalar Bots"), STAT_CharacterMovementISPCScalarBots, STATGROUP_UnrCppChar);
+DECLARE_CYCLE_STAT(TEXT("UnrCpp Char Parallel Tick"), STAT_CharacterMovementParallelTick, STATGROUP_UnrCppChar);
+DECLARE_CYCLE_STAT(TEXT("UnrCpp Char Parallel Replay"), STAT_CharacterMovementParallelReplay, STATGROUP_UnrCppChar);
+DECLARE_CYCLE_STAT(TEXT("UnrCpp Char Parallel Game Thread Time"), STAT_CharacterMovementParallelGameThread, STATGROUP_UnrCppChar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("UnrCpp Char Parallel Game Thread Calls"), STAT_CharacterMovementParallelGameThreadCalls, STATGROUP_UnrCppChar);
+DECLARE_CYCLE_STAT(TEXT("UnrCpp Char Deliver Events"), STAT_CharacterMovementDeliverEvents, STATGROUP_UnrCppChar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("UnrCpp Char Queued Events"), STAT_CharacterMovementQueuedEvents, STATGROUP_UnrCppChar);
+DECLARE_CYCLE_STAT(TEXT("UnrCpp Char LOD Update"), STAT_CharacterMovementLODUpdate, STATGROUP_UnrCppChar);
+DECLARE_CYCLE_STAT(TEXT("UnrCpp Char LOD Interpolation"), STAT_CharacterMovementLODInterpolation, STATGROUP_UnrCppChar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("UnrCpp Char LOD Skipped Bots"), STAT_CharacterMovementLODSkipped, STATGROUP_UnrCppChar);
+DECLARE_CYCLE_STAT(TEXT("UnrCpp Char Bot Broadphase Build"), STAT_CharBotBroadphaseBuild, STATGROUP_UnrCppChar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("UnrCpp Char Bot Contacts"), STAT_CharBotContacts, STATGROUP_UnrCppChar);
+DECLARE_CYCLE_STAT(TEXT("UnrCpp Char Collision Params Refresh"), STAT_CharCollisionParamsRefresh, STATGROUP_UnrCppChar);
+DECLARE_DWORD_COUNTER_STAT(TEXT("UnrCpp Char Collision Params Rebuilds"), STAT_CharCollisionParamsRebuilds, STATGROUP_UnrCppChar);
+DECLARE_CYCLE_STAT(TEXT("UnrCpp Char Walkable Slope Flush"), STAT_CharWalkableSlopeFlush, STATGROUP_UnrCppChar);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("UnrCpp Char Walkable Slope Entries"), STAT_CharWalkableSlopeEntries, STATGROUP_UnrCppChar);
 
 // MAGIC NUMBERS
 const float MAX_STEP_SIDE_Z = 0.08f;	// maximum z value for the normal on the vertical side of steps
 const float SWIMBOBSPEED = -80.f;
 const float VERTICAL_SLOPE_NORMAL_Z = 0.001f; // Slope is vertical if Abs(Normal.Z) <= this threshold. Accounts for precision problems that sometimes angle normals slightly off horizontal for vertical surface.
 
+static TAutoConsoleVariable<int32> CVarISPCMovementChunkSize(
+	TEXT("ispc.MovementChunkSize"),
+	0,
+	TEXT("Number of bots per task when ticking movement in ISPC (ispc.MovementImplementation 2).\n")
+	TEXT("0 (default): tick all bots in a single foreach on the game thread\n")
+	TEXT(">0: split the bots into chunks of this size and tick them in parallel on the task graph"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarISPCMovementBucketing(
+	TEXT("ispc.MovementBucketing"),
+	0,
+	TEXT("Whether to partition bots by movement mode before running the ISPC physics step (ispc.MovementImplementation 2).\n")
+	TEXT("0 (default): one kernel over all bots, mixed movement modes diverge within a gang\n")
+	TEXT("1: per-mode kernels over contiguous buckets; bots changing mode mid-tick are re-queued into their new bucket"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarCppMovementParallel(
+	TEXT("ispc.CppMovementParallel"),
+	0,
+	TEXT("Whether to tick the unrolled C++ movement system (ispc.MovementImplementation 1) on task graph workers.\n")
+	TEXT("0 (default): serial loop on the game thread\n")
+	TEXT("1: work-stealing over batches of ispc.CppMovementBatchSize bots; game-thread-only calls are marshalled or deferred"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarCppMovementBatchSize(
+	TEXT("ispc.CppMovementBatchSize"),
+	16,
+	TEXT("Number of bots per work-stealing batch when ispc.CppMovementParallel is enabled.\n")
+	TEXT("Small enough for a batch's components to stay cache resident, large enough to amortise scheduling."),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarCppNavWalkingBatching(
+	TEXT("ispc.CppNavWalkingBatching"),
+	1,
+	TEXT("Whether the serial unrolled C++ tick batches the navmesh projections of NavWalking bots.\n")
+	TEXT("0: project each bot's destination on its own during its PerformMovement()\n")
+	TEXT("1 (default): move NavWalking bots in passes, with a single projection batch per navmesh"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarFloorCacheTolerance(
+	TEXT("ispc.FloorCacheTolerance"),
+	4.f,
+	TEXT("Distance a bot may move from its last floor sweep on flat ground before FindFloor() sweeps again.\n")
+	TEXT("Bots can step up to this far past the edge of a floor before noticing it. 0 disables the floor cache."),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarAnalyticFloor(
+	TEXT("ispc.AnalyticFloor"),
+	0,
+	TEXT("Whether floor sweeps onto the top of a static box-shaped floor are computed analytically instead of by PhysX.\n")
+	TEXT("0 (default): always sweep\n")
+	TEXT("1: skip the sweep away from the edges of the bot's current floor; other geometry above it is not seen"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarImmediateMovementEvents(
+	TEXT("ispc.ImmediateMovementEvents"),
+	0,
+	TEXT("Mask of movement event types delivered from within the movement tick instead of being queued until its end.\n")
+	TEXT("1: OnCharacterMovementUpdated, 2: Landed, 4: NotifyJumpApex, 8: HandleImpact, 16: stuck in geometry warning, 32: OnMovementModeChanged\n")
+	TEXT("0 (default): queue all events, -1: disable the queue. Game code can opt out with SetImmediateMovementEvent()."),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarMovementLOD(
+	TEXT("ispc.MovementLOD"),
+	0,
+	TEXT("Whether the unrolled C++ system ticks bots far from all players at a reduced rate (ispc.MovementLODDistance*).\n")
+	TEXT("0 (default): every bot moves every frame\n")
+	TEXT("1: bots tick at 1/2, 1/4 or 1/8 rate with the accumulated frame time, staggered across frames"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarMovementLODDistance2(
+	TEXT("ispc.MovementLODDistance2"),
+	3000.f,
+	TEXT("Distance from the nearest player beyond which bots tick every 2nd frame (ispc.MovementLOD=1). 0 disables this level."),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarMovementLODDistance4(
+	TEXT("ispc.MovementLODDistance4"),
+	6000.f,
+	TEXT("Distance from the nearest player beyond which bots tick every 4th frame (ispc.MovementLOD=1). 0 disables this level."),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarMovementLODDistance8(
+	TEXT("ispc.MovementLODDistance8"),
+	12000.f,
+	TEXT("Distance from the nearest player beyond which bots tick every 8th frame (ispc.MovementLOD=1). 0 disables this level."),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarMovementLODInterpolation(
+	TEXT("ispc.MovementLODInterpolation"),
+	1,
+	TEXT("Whether the meshes of bots ticking at a reduced rate are interpolated between their ticks. Ignored on dedicated servers."),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarBotBroadphase(
+	TEXT("ispc.BotBroadphase"),
+	0,
+	TEXT("Whether the unrolled C++ system resolves bot-vs-bot contacts against its own spatial hash instead of PhysX.\n")
+	TEXT("0 (default): movement sweeps hit other bots in the physics scene\n")
+	TEXT("1: bot capsules use the ispc.BotBroadphaseChannel object type and ignore each other in the physics scene;\n")
+	TEXT("   object queries for ECC_Pawn no longer find bots, and bots can't be a floor for each other"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarBotBroadphaseCellSize(
+	TEXT("ispc.BotBroadphaseCellSize"),
+	200.f,
+	TEXT("Size of the bot broadphase grid cells. Around twice the bot capsule radius keeps the cells searched per sweep few."),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarBotBroadphaseChannel(
+	TEXT("ispc.BotBroadphaseChannel"),
+	18,
+	TEXT("ECC_GameTraceChannel (1-18) bot capsules are switched to with ispc.BotBroadphase. Must not be used by the project,\n")
+	TEXT("so that everything but other bots keeps blocking it."),
+	ECVF_Default
+);
+
 namespace CVars
 {
 	static IConsoleVariable* MoveIgnoreFirstBlockingOverlap = nullptr;
 	static IConsoleVariable* CharacterStuckWarningPeriod = nullptr;
 	static IConsoleVariable* VisualizeMovement = nullptr;
+	static IConsoleVariable* MovementImplementation = nullptr;
 }
 
-static UShooterUnrolledCppMovementSystem* GetMovementSystem(UShooterUnrolledCppMovement* Comp)
+namespace FloorCache
 {
-	if (UWorld* World = Comp->GetWorld())
+	/** Bumped on every collision geometry change that invalidates cached floors. Starts at 1, 0 marks an empty cache. */
+	static uint32 GeometryVersion = 1;
+
+	/** Floors with a lower normal Z aren't cached, as moving across them changes the floor distance. */
+	static const float MinNormalZ = 0.9999f;
+
+	static void Invalidate()
+	{
+		++GeometryVersion;
+		// Skip 0 on wrap-around.
+		GeometryVersion += (GeometryVersion == 0);
+	}
+
+	static void OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+	{
+		Invalidate();
+	}
+
+	static void OnLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+	{
+		Invalidate();
+	}
+
+	static FAutoConsoleCommand InvalidateCommand(
+		TEXT("ispc.InvalidateFloorCaches"),
+		TEXT("Drops all bots' cached floor sweeps, forcing a new FindFloor() sweep."),
+		FConsoleCommandDelegate::CreateStatic(&Invalidate));
+}
+
+/**
+ * Movement systems by level. Every level (persistent or streaming) gets its own system, which registers its
+ * tick function with that level, so that a streaming level's bots are ticked and torn down along with it.
+ * The systems are kept alive by their world's ExtraReferencedObjects; the map only serves lookups.
+ */
+namespace MovementSystemRegistry
+{
+	static TMap<const ULevel*, UShooterUnrolledCppMovementSystem*> Systems;
+	static bool bDelegatesRegistered = false;
+
+	static void Release(UShooterUnrolledCppMovementSystem* System)
+	{
+		System->Uninitialize();
+		if (UWorld* World = System->GetWorld())
+		{
+			World->ExtraReferencedObjects.RemoveSingleSwap(System, false);
+		}
+	}
+
+	static void OnLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+	{
+		// A null level means that all of the world's levels are going away.
+		for (auto It = Systems.CreateIterator(); It; ++It)
+		{
+			if (Level ? It.Key() == Level : It.Value()->GetWorld() == World)
+			{
+				Release(It.Value());
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	static void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+	{
+		OnLevelRemovedFromWorld(nullptr, World);
+	}
+
+	static UShooterUnrolledCppMovementSystem* Find(const ULevel* Level)
+	{
+		UShooterUnrolledCppMovementSystem** System = Systems.Find(Level);
+		return System ? *System : nullptr;
+	}
+
+	static UShooterUnrolledCppMovementSystem* FindOrCreate(ULevel* Level)
 	{
-		UClass* SystemClass = UShooterUnrolledCppMovementSystem::StaticClass();
-		if (UObject** SysAsObj = World->ExtraReferencedObjects.FindByPredicate([SystemClass](const UObject* Obj) { return Obj->GetClass() == SystemClass; }))
+		if (UShooterUnrolledCppMovementSystem* System = Find(Level))
 		{
-			return static_cast<UShooterUnrolledCppMovementSystem*>(*SysAsObj);
+			return System;
 		}
-		UShooterUnrolledCppMovementSystem* System = NewObject<UShooterUnrolledCppMovementSystem>(World, MakeUniqueObjectName(World, SystemClass));
+
+		if (!bDelegatesRegistered)
+		{
+			FWorldDelegates::LevelRemovedFromWorld.AddStatic(&OnLevelRemovedFromWorld);
+			FWorldDelegates::OnWorldCleanup.AddStatic(&OnWorldCleanup);
+			// Streaming levels in and out changes the collision geometry bots may have cached floors on.
+			FWorldDelegates::LevelAddedToWorld.AddStatic(&FloorCache::OnLevelAddedToWorld);
+			FWorldDelegates::LevelRemovedFromWorld.AddStatic(&FloorCache::OnLevelRemovedFromWorld);
+			bDelegatesRegistered = true;
+		}
+
+		UWorld* World = Level->OwningWorld;
+		UShooterUnrolledCppMovementSystem* System = NewObject<UShooterUnrolledCppMovementSystem>(Level, MakeUniqueObjectName(Level, UShooterUnrolledCppMovementSystem::StaticClass()));
 		World->ExtraReferencedObjects.Add(System);
+		Systems.Add(Level, System);
 		System->Initialize();
 		return System;
 	}
-	return nullptr;
+}
+
+/** Returns the system ticking Comp's level. Only creates one when asked to, so that teardown never spawns systems. */
+static UShooterUnrolledCppMovementSystem* GetMovementSystem(UShooterUnrolledCppMovement* Comp, bool bCreate)
+{
+	ULevel* Level = Comp->GetComponentLevel();
+	if (Level == nullptr || Level->OwningWorld == nullptr)
+	{
+		return nullptr;
+	}
+	return bCreate ? MovementSystemRegistry::FindOrCreate(Level) : MovementSystemRegistry::Find(Level);
 }
 
 UShooterUnrolledCppMovement::UShooterUnrolledCppMovement(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, SystemIndex(INDEX_NONE)
 {
 	bWantsInitializeComponent = true;
 }
@@ -82,17 +341,27 @@ void UShooterUnrolledCppMovement::InitializeComponent()
 {
 	Super::InitializeComponent();
 
-	if (UShooterUnrolledCppMovementSystem* System = GetMovementSystem(this))
+	if (UShooterUnrolledCppMovementSystem* System = GetMovementSystem(this, true))
 	{
 		System->RegisterComponent(this);
 	}
 }
 
+void UShooterUnrolledCppMovement::PhysicsVolumeChanged(APhysicsVolume* NewVolume)
+{
+	Super::PhysicsVolumeChanged(NewVolume);
+
+	if (UShooterUnrolledCppMovementSystem* System = GetMovementSystem(this, false))
+	{
+		System->UpdatePhysicsVolumeSnapshot(this);
+	}
+}
+
 void UShooterUnrolledCppMovement::UninitializeComponent()
 {
 	Super::UninitializeComponent();
 
-	if (UShooterUnrolledCppMovementSystem* System = GetMovementSystem(this))
+	if (UShooterUnrolledCppMovementSystem* System = GetMovementSystem(this, false))
 	{
 		System->UnregisterComponent(this);
 	}
@@ -294,6 +563,7 @@ FString FSystemTickFunction::DiagnosticMessage()
 
 UShooterUnrolledCppMovementSystem::UShooterUnrolledCppMovementSystem(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, LastTickCycles(0)
 {
 	TickFunction.bCanEverTick = true;
 	TickFunction.bStartWithTickEnabled = false;
@@ -307,16 +577,53 @@ void UShooterUnrolledCppMovementSystem::Initialize()
 	CVars::MoveIgnoreFirstBlockingOverlap = IConsoleManager::Get().FindConsoleVariable(TEXT("p.MoveIgnoreFirstBlockingOverlap"));
 	CVars::CharacterStuckWarningPeriod = IConsoleManager::Get().FindConsoleVariable(TEXT("p.CharacterStuckWarningPeriod"));
 	CVars::VisualizeMovement = IConsoleManager::Get().FindConsoleVariable(TEXT("p.VisualizeMovement"));
+	CVars::MovementImplementation = IConsoleManager::Get().FindConsoleVariable(TEXT("ispc.MovementImplementation"));
+
+	static bool bLoggedISPCTarget = false;
+	if (!bLoggedISPCTarget)
+	{
+		UE_LOG(LogUnrolledCharacterMovement, Log, TEXT("ISPC movement kernel dispatched to %s, %d lanes wide"), GetISPCTargetName(), ispc::GetProgramCount());
+		bLoggedISPCTarget = true;
+	}
 
 	TickFunction.System = this;
 	if (!IsTemplate())
 	{
-		ULevel* Level = GetWorld()->PersistentLevel;
+		ULevel* Level = CastChecked<ULevel>(GetOuter());
 		TickFunction.SetTickFunctionEnable(true);
 		TickFunction.RegisterTickFunction(Level);
 	}
 }
 
+const TCHAR* UShooterUnrolledCppMovementSystem::GetISPCTargetName()
+{
+	return GetISPCTargetName(ispc::GetTargetISA());
+}
+
+const TCHAR* UShooterUnrolledCppMovementSystem::GetISPCTargetName(int32 ISA)
+{
+	// Indexed by GetTargetISA() in ShooterISPCMovementSystem.ispc.
+	static const TCHAR* Names[] = { TEXT("unknown"), TEXT("SSE2"), TEXT("SSE4"), TEXT("AVX"), TEXT("AVX2"), TEXT("AVX-512 (SKX)"), TEXT("NEON") };
+	return Names[(ISA >= 0 && ISA < ARRAY_COUNT(Names)) ? ISA : 0];
+}
+
+UShooterUnrolledCppMovementSystem* UShooterUnrolledCppMovementSystem::FindForLevel(const ULevel* Level)
+{
+	return MovementSystemRegistry::Find(Level);
+}
+
+void UShooterUnrolledCppMovementSystem::InvalidateFloorCaches()
+{
+	FloorCache::Invalidate();
+}
+
+void UShooterUnrolledCppMovementSystem::SetImmediateMovementEvent(EMovementEventType Type, bool bImmediate)
+{
+	check(IsInGameThread());
+	const uint32 Bit = 1u << (uint32)Type;
+	ImmediateMovementEvents = bImmediate ? (ImmediateMovementEvents | Bit) : (ImmediateMovementEvents & ~Bit);
+}
+
 void UShooterUnrolledCppMovementSystem::Uninitialize()
 {
 	TickFunction.UnRegisterTickFunction();
@@ -330,12 +637,66 @@ void UShooterUnrolledCppMovementSystem::BeginDestroy()
 
 void UShooterUnrolledCppMovementSystem::RegisterComponent(UShooterUnrolledCppMovement* Comp)
 {
-	Components.Add(Comp);
+	if (Comp->SystemIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	Comp->SystemIndex = Components.Add(Comp);
+	ISPCStore.AddSlots(1);
+	CollisionParamsPool.AddDefaulted(1);
+	UpdatePhysicsVolumeSnapshot(Comp);
 	Comp->PrimaryComponentTick.AddPrerequisite(this, TickFunction);
 }
 
 void UShooterUnrolledCppMovementSystem::UnregisterComponent(UShooterUnrolledCppMovement* Comp)
 {
+	const int32 Index = Comp->SystemIndex;
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+	check(Components[Index] == Comp);
+
 	Comp->PrimaryComponentTick.RemovePrerequisite(this, TickFunction);
-	Components.Remove(Comp);
+	SetBotBroadphaseCollision(Comp, false);
+	BotBroadphase.RemoveSwap(Index);
+	Comp->SystemIndex = INDEX_NONE;
+
+	// Swap and pop. The last component takes over the hole, along with its SoA slot.
+	Components.RemoveAtSwap(Index, 1, false);
+	ISPCStore.RemoveSlotSwap(Index);
+	CollisionParamsPool.RemoveAtSwap(Index, 1, false);
+	if (Index < Components.Num())
+	{
+		Components[Index]->SystemIndex = Index;
+	}
+}
+
+void UShooterUnrolledCppMovementSystem::RegisterComponents(const TArray<UShooterUnrolledCppMovement*>& Comps)
+{
+	const int32 FirstIndex = Components.Num();
+	Components.Reserve(FirstIndex + Comps.Num());
+	for (UShooterUnrolledCppMovement* Comp : Comps)
+	{
+		if (Comp->SystemIndex == INDEX_NONE)
+		{
+			Comp->SystemIndex = Components.Add(Comp);
+			Comp->PrimaryComponentTick.AddPrerequisite(this, TickFunction);
+		}
+	}
+	ISPCStore.AddSlots(Components.Num() - FirstIndex);
+	CollisionParamsPool.AddDefaulted(Components.Num() - FirstIndex);
+	for (int32 Index = FirstIndex; Index < Components.Num(); ++Index)
+	{
+		UpdatePhysicsVolumeSnapshot(Components[Index]);
+	}
+}
+
+void UShooterUnrolledCppMovementSystem::UnregisterComponents(const TArray<UShooterUnrolledCppMovement*>& Comps)
+{
+	for (UShooterUnrolledCppMovement* Comp : Comps)
+	{
+		UnregisterComponent(Comp);
+	}
 }
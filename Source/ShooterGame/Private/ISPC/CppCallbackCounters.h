@@ -0,0 +1,51 @@
+#pragma once
+
+/**
+ * Tally of the calls the ISPC kernel makes into C++. Off by default; the movement benchmark commandlet turns it
+ * on to report callbacks per frame and how many lanes the gang-wide calls actually served.
+ */
+struct FCppCallbackCounters
+{
+	static bool bEnabled;
+	/** Per-lane calls (DefineCppCallback_*). */
+	static volatile int64 LaneCalls;
+	/** Gang-wide calls (DefineCppGangCallback_* and the batched scene queries). */
+	static volatile int64 GangCalls;
+	/** Sum of active lanes over all gang-wide calls. */
+	static volatile int64 GangActiveLanes;
+
+	static FORCEINLINE void RecordLaneCall()
+	{
+		if (bEnabled)
+		{
+			FPlatformAtomics::InterlockedIncrement(&LaneCalls);
+		}
+	}
+
+	static FORCEINLINE void RecordGangCall(int32 LaneMask)
+	{
+		if (bEnabled)
+		{
+			int64 ActiveLanes = 0;
+			for (uint32 Mask = (uint32)LaneMask; Mask != 0; Mask &= Mask - 1)
+			{
+				++ActiveLanes;
+			}
+			RecordBatch(ActiveLanes);
+		}
+	}
+
+	static FORCEINLINE void RecordBatch(int64 ActiveLanes)
+	{
+		if (bEnabled)
+		{
+			FPlatformAtomics::InterlockedIncrement(&GangCalls);
+			FPlatformAtomics::InterlockedAdd(&GangActiveLanes, ActiveLanes);
+		}
+	}
+
+	static void Reset()
+	{
+		LaneCalls = GangCalls = GangActiveLanes = 0;
+	}
+};
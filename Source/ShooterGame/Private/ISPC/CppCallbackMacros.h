@@ -22,6 +22,7 @@
 			{	\
 				ReturnValue = insert(ReturnValue, Index, FuncName ## _CppCallback ArgFwd);	\
 			}	\
+			return ReturnValue;	\
 		}
 
 	#define DefineCppCallback_0Arg(FuncName, CppCode)	\
@@ -64,6 +65,330 @@
 		_CppCallbackTemplate_RetVal(ReturnType, FuncName, (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2, ArgType3 varying Arg3, ArgType4 varying Arg4, ArgType5 varying Arg5, ArgType6 varying Arg6, ArgType7 varying Arg7), (ArgType0 uniform Arg0, ArgType1 uniform Arg1, ArgType2 uniform Arg2, ArgType3 uniform Arg3, ArgType4 uniform Arg4, ArgType5 uniform Arg5, ArgType6 uniform Arg6, ArgType7 uniform Arg7), (extract(Arg0, Index), extract(Arg1, Index), extract(Arg2, Index), extract(Arg3, Index), extract(Arg4, Index), extract(Arg5, Index), extract(Arg6, Index), extract(Arg7, Index)))
 	#define DefineCppCallback_9Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, ArgType8, Arg8, CppCode)	\
 		_CppCallbackTemplate_RetVal(ReturnType, FuncName, (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2, ArgType3 varying Arg3, ArgType4 varying Arg4, ArgType5 varying Arg5, ArgType6 varying Arg6, ArgType7 varying Arg7, ArgType8 varying Arg8), (ArgType0 uniform Arg0, ArgType1 uniform Arg1, ArgType2 uniform Arg2, ArgType3 uniform Arg3, ArgType4 uniform Arg4, ArgType5 uniform Arg5, ArgType6 uniform Arg6, ArgType7 uniform Arg7, ArgType8 uniform Arg8), (extract(Arg0, Index), extract(Arg1, Index), extract(Arg2, Index), extract(Arg3, Index), extract(Arg4, Index), extract(Arg5, Index), extract(Arg6, Index), extract(Arg7, Index), extract(Arg8, Index)))
+
+	// Gang flavour: one call per gang instead of one per active lane. Arguments and return values are passed
+	// as uniform arrays indexed by lane, along with the mask of active lanes. Argument types must not be
+	// top-level const.
+	#define DefineCppGangCallback_0Arg(FuncName, CppCode)	\
+		inline void FuncName ()	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask);	\
+			FuncName ## _CppGangCallback (lanemask());	\
+		}
+	#define DefineCppGangCallback_1Arg(FuncName, ArgType0, Arg0, CppCode)	\
+		inline void FuncName (ArgType0 varying Arg0)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ArgType0 uniform * uniform _Lanes0);	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			FuncName ## _CppGangCallback (lanemask(), _Lanes0);	\
+		}
+	#define DefineCppGangCallback_2Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, CppCode)	\
+		inline void FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1);	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			FuncName ## _CppGangCallback (lanemask(), _Lanes0, _Lanes1);	\
+		}
+	#define DefineCppGangCallback_3Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, CppCode)	\
+		inline void FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1, ArgType2 uniform * uniform _Lanes2);	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			ArgType2 uniform _Lanes2[programCount];	\
+			_Lanes2[programIndex] = Arg2;	\
+			FuncName ## _CppGangCallback (lanemask(), _Lanes0, _Lanes1, _Lanes2);	\
+		}
+	#define DefineCppGangCallback_4Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, CppCode)	\
+		inline void FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2, ArgType3 varying Arg3)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1, ArgType2 uniform * uniform _Lanes2, ArgType3 uniform * uniform _Lanes3);	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			ArgType2 uniform _Lanes2[programCount];	\
+			_Lanes2[programIndex] = Arg2;	\
+			ArgType3 uniform _Lanes3[programCount];	\
+			_Lanes3[programIndex] = Arg3;	\
+			FuncName ## _CppGangCallback (lanemask(), _Lanes0, _Lanes1, _Lanes2, _Lanes3);	\
+		}
+	#define DefineCppGangCallback_5Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, CppCode)	\
+		inline void FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2, ArgType3 varying Arg3, ArgType4 varying Arg4)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1, ArgType2 uniform * uniform _Lanes2, ArgType3 uniform * uniform _Lanes3, ArgType4 uniform * uniform _Lanes4);	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			ArgType2 uniform _Lanes2[programCount];	\
+			_Lanes2[programIndex] = Arg2;	\
+			ArgType3 uniform _Lanes3[programCount];	\
+			_Lanes3[programIndex] = Arg3;	\
+			ArgType4 uniform _Lanes4[programCount];	\
+			_Lanes4[programIndex] = Arg4;	\
+			FuncName ## _CppGangCallback (lanemask(), _Lanes0, _Lanes1, _Lanes2, _Lanes3, _Lanes4);	\
+		}
+	#define DefineCppGangCallback_6Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, CppCode)	\
+		inline void FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2, ArgType3 varying Arg3, ArgType4 varying Arg4, ArgType5 varying Arg5)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1, ArgType2 uniform * uniform _Lanes2, ArgType3 uniform * uniform _Lanes3, ArgType4 uniform * uniform _Lanes4, ArgType5 uniform * uniform _Lanes5);	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			ArgType2 uniform _Lanes2[programCount];	\
+			_Lanes2[programIndex] = Arg2;	\
+			ArgType3 uniform _Lanes3[programCount];	\
+			_Lanes3[programIndex] = Arg3;	\
+			ArgType4 uniform _Lanes4[programCount];	\
+			_Lanes4[programIndex] = Arg4;	\
+			ArgType5 uniform _Lanes5[programCount];	\
+			_Lanes5[programIndex] = Arg5;	\
+			FuncName ## _CppGangCallback (lanemask(), _Lanes0, _Lanes1, _Lanes2, _Lanes3, _Lanes4, _Lanes5);	\
+		}
+	#define DefineCppGangCallback_7Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, CppCode)	\
+		inline void FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2, ArgType3 varying Arg3, ArgType4 varying Arg4, ArgType5 varying Arg5, ArgType6 varying Arg6)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1, ArgType2 uniform * uniform _Lanes2, ArgType3 uniform * uniform _Lanes3, ArgType4 uniform * uniform _Lanes4, ArgType5 uniform * uniform _Lanes5, ArgType6 uniform * uniform _Lanes6);	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			ArgType2 uniform _Lanes2[programCount];	\
+			_Lanes2[programIndex] = Arg2;	\
+			ArgType3 uniform _Lanes3[programCount];	\
+			_Lanes3[programIndex] = Arg3;	\
+			ArgType4 uniform _Lanes4[programCount];	\
+			_Lanes4[programIndex] = Arg4;	\
+			ArgType5 uniform _Lanes5[programCount];	\
+			_Lanes5[programIndex] = Arg5;	\
+			ArgType6 uniform _Lanes6[programCount];	\
+			_Lanes6[programIndex] = Arg6;	\
+			FuncName ## _CppGangCallback (lanemask(), _Lanes0, _Lanes1, _Lanes2, _Lanes3, _Lanes4, _Lanes5, _Lanes6);	\
+		}
+	#define DefineCppGangCallback_8Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, CppCode)	\
+		inline void FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2, ArgType3 varying Arg3, ArgType4 varying Arg4, ArgType5 varying Arg5, ArgType6 varying Arg6, ArgType7 varying Arg7)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1, ArgType2 uniform * uniform _Lanes2, ArgType3 uniform * uniform _Lanes3, ArgType4 uniform * uniform _Lanes4, ArgType5 uniform * uniform _Lanes5, ArgType6 uniform * uniform _Lanes6, ArgType7 uniform * uniform _Lanes7);	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			ArgType2 uniform _Lanes2[programCount];	\
+			_Lanes2[programIndex] = Arg2;	\
+			ArgType3 uniform _Lanes3[programCount];	\
+			_Lanes3[programIndex] = Arg3;	\
+			ArgType4 uniform _Lanes4[programCount];	\
+			_Lanes4[programIndex] = Arg4;	\
+			ArgType5 uniform _Lanes5[programCount];	\
+			_Lanes5[programIndex] = Arg5;	\
+			ArgType6 uniform _Lanes6[programCount];	\
+			_Lanes6[programIndex] = Arg6;	\
+			ArgType7 uniform _Lanes7[programCount];	\
+			_Lanes7[programIndex] = Arg7;	\
+			FuncName ## _CppGangCallback (lanemask(), _Lanes0, _Lanes1, _Lanes2, _Lanes3, _Lanes4, _Lanes5, _Lanes6, _Lanes7);	\
+		}
+	#define DefineCppGangCallback_9Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, ArgType8, Arg8, CppCode)	\
+		inline void FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2, ArgType3 varying Arg3, ArgType4 varying Arg4, ArgType5 varying Arg5, ArgType6 varying Arg6, ArgType7 varying Arg7, ArgType8 varying Arg8)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1, ArgType2 uniform * uniform _Lanes2, ArgType3 uniform * uniform _Lanes3, ArgType4 uniform * uniform _Lanes4, ArgType5 uniform * uniform _Lanes5, ArgType6 uniform * uniform _Lanes6, ArgType7 uniform * uniform _Lanes7, ArgType8 uniform * uniform _Lanes8);	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			ArgType2 uniform _Lanes2[programCount];	\
+			_Lanes2[programIndex] = Arg2;	\
+			ArgType3 uniform _Lanes3[programCount];	\
+			_Lanes3[programIndex] = Arg3;	\
+			ArgType4 uniform _Lanes4[programCount];	\
+			_Lanes4[programIndex] = Arg4;	\
+			ArgType5 uniform _Lanes5[programCount];	\
+			_Lanes5[programIndex] = Arg5;	\
+			ArgType6 uniform _Lanes6[programCount];	\
+			_Lanes6[programIndex] = Arg6;	\
+			ArgType7 uniform _Lanes7[programCount];	\
+			_Lanes7[programIndex] = Arg7;	\
+			ArgType8 uniform _Lanes8[programCount];	\
+			_Lanes8[programIndex] = Arg8;	\
+			FuncName ## _CppGangCallback (lanemask(), _Lanes0, _Lanes1, _Lanes2, _Lanes3, _Lanes4, _Lanes5, _Lanes6, _Lanes7, _Lanes8);	\
+		}
+	#define DefineCppGangCallback_0Arg_RetVal(ReturnType, FuncName, CppCode)	\
+		inline ReturnType varying FuncName ()	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ReturnType uniform * uniform _ReturnValues);	\
+			ReturnType uniform _ReturnValues[programCount];	\
+			FuncName ## _CppGangCallback (lanemask(), _ReturnValues);	\
+			return _ReturnValues[programIndex];	\
+		}
+	#define DefineCppGangCallback_1Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, CppCode)	\
+		inline ReturnType varying FuncName (ArgType0 varying Arg0)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ReturnType uniform * uniform _ReturnValues, ArgType0 uniform * uniform _Lanes0);	\
+			ReturnType uniform _ReturnValues[programCount];	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			FuncName ## _CppGangCallback (lanemask(), _ReturnValues, _Lanes0);	\
+			return _ReturnValues[programIndex];	\
+		}
+	#define DefineCppGangCallback_2Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, CppCode)	\
+		inline ReturnType varying FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ReturnType uniform * uniform _ReturnValues, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1);	\
+			ReturnType uniform _ReturnValues[programCount];	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			FuncName ## _CppGangCallback (lanemask(), _ReturnValues, _Lanes0, _Lanes1);	\
+			return _ReturnValues[programIndex];	\
+		}
+	#define DefineCppGangCallback_3Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, CppCode)	\
+		inline ReturnType varying FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ReturnType uniform * uniform _ReturnValues, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1, ArgType2 uniform * uniform _Lanes2);	\
+			ReturnType uniform _ReturnValues[programCount];	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			ArgType2 uniform _Lanes2[programCount];	\
+			_Lanes2[programIndex] = Arg2;	\
+			FuncName ## _CppGangCallback (lanemask(), _ReturnValues, _Lanes0, _Lanes1, _Lanes2);	\
+			return _ReturnValues[programIndex];	\
+		}
+	#define DefineCppGangCallback_4Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, CppCode)	\
+		inline ReturnType varying FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2, ArgType3 varying Arg3)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ReturnType uniform * uniform _ReturnValues, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1, ArgType2 uniform * uniform _Lanes2, ArgType3 uniform * uniform _Lanes3);	\
+			ReturnType uniform _ReturnValues[programCount];	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			ArgType2 uniform _Lanes2[programCount];	\
+			_Lanes2[programIndex] = Arg2;	\
+			ArgType3 uniform _Lanes3[programCount];	\
+			_Lanes3[programIndex] = Arg3;	\
+			FuncName ## _CppGangCallback (lanemask(), _ReturnValues, _Lanes0, _Lanes1, _Lanes2, _Lanes3);	\
+			return _ReturnValues[programIndex];	\
+		}
+	#define DefineCppGangCallback_5Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, CppCode)	\
+		inline ReturnType varying FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2, ArgType3 varying Arg3, ArgType4 varying Arg4)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ReturnType uniform * uniform _ReturnValues, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1, ArgType2 uniform * uniform _Lanes2, ArgType3 uniform * uniform _Lanes3, ArgType4 uniform * uniform _Lanes4);	\
+			ReturnType uniform _ReturnValues[programCount];	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			ArgType2 uniform _Lanes2[programCount];	\
+			_Lanes2[programIndex] = Arg2;	\
+			ArgType3 uniform _Lanes3[programCount];	\
+			_Lanes3[programIndex] = Arg3;	\
+			ArgType4 uniform _Lanes4[programCount];	\
+			_Lanes4[programIndex] = Arg4;	\
+			FuncName ## _CppGangCallback (lanemask(), _ReturnValues, _Lanes0, _Lanes1, _Lanes2, _Lanes3, _Lanes4);	\
+			return _ReturnValues[programIndex];	\
+		}
+	#define DefineCppGangCallback_6Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, CppCode)	\
+		inline ReturnType varying FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2, ArgType3 varying Arg3, ArgType4 varying Arg4, ArgType5 varying Arg5)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ReturnType uniform * uniform _ReturnValues, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1, ArgType2 uniform * uniform _Lanes2, ArgType3 uniform * uniform _Lanes3, ArgType4 uniform * uniform _Lanes4, ArgType5 uniform * uniform _Lanes5);	\
+			ReturnType uniform _ReturnValues[programCount];	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			ArgType2 uniform _Lanes2[programCount];	\
+			_Lanes2[programIndex] = Arg2;	\
+			ArgType3 uniform _Lanes3[programCount];	\
+			_Lanes3[programIndex] = Arg3;	\
+			ArgType4 uniform _Lanes4[programCount];	\
+			_Lanes4[programIndex] = Arg4;	\
+			ArgType5 uniform _Lanes5[programCount];	\
+			_Lanes5[programIndex] = Arg5;	\
+			FuncName ## _CppGangCallback (lanemask(), _ReturnValues, _Lanes0, _Lanes1, _Lanes2, _Lanes3, _Lanes4, _Lanes5);	\
+			return _ReturnValues[programIndex];	\
+		}
+	#define DefineCppGangCallback_7Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, CppCode)	\
+		inline ReturnType varying FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2, ArgType3 varying Arg3, ArgType4 varying Arg4, ArgType5 varying Arg5, ArgType6 varying Arg6)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ReturnType uniform * uniform _ReturnValues, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1, ArgType2 uniform * uniform _Lanes2, ArgType3 uniform * uniform _Lanes3, ArgType4 uniform * uniform _Lanes4, ArgType5 uniform * uniform _Lanes5, ArgType6 uniform * uniform _Lanes6);	\
+			ReturnType uniform _ReturnValues[programCount];	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			ArgType2 uniform _Lanes2[programCount];	\
+			_Lanes2[programIndex] = Arg2;	\
+			ArgType3 uniform _Lanes3[programCount];	\
+			_Lanes3[programIndex] = Arg3;	\
+			ArgType4 uniform _Lanes4[programCount];	\
+			_Lanes4[programIndex] = Arg4;	\
+			ArgType5 uniform _Lanes5[programCount];	\
+			_Lanes5[programIndex] = Arg5;	\
+			ArgType6 uniform _Lanes6[programCount];	\
+			_Lanes6[programIndex] = Arg6;	\
+			FuncName ## _CppGangCallback (lanemask(), _ReturnValues, _Lanes0, _Lanes1, _Lanes2, _Lanes3, _Lanes4, _Lanes5, _Lanes6);	\
+			return _ReturnValues[programIndex];	\
+		}
+	#define DefineCppGangCallback_8Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, CppCode)	\
+		inline ReturnType varying FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2, ArgType3 varying Arg3, ArgType4 varying Arg4, ArgType5 varying Arg5, ArgType6 varying Arg6, ArgType7 varying Arg7)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ReturnType uniform * uniform _ReturnValues, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1, ArgType2 uniform * uniform _Lanes2, ArgType3 uniform * uniform _Lanes3, ArgType4 uniform * uniform _Lanes4, ArgType5 uniform * uniform _Lanes5, ArgType6 uniform * uniform _Lanes6, ArgType7 uniform * uniform _Lanes7);	\
+			ReturnType uniform _ReturnValues[programCount];	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			ArgType2 uniform _Lanes2[programCount];	\
+			_Lanes2[programIndex] = Arg2;	\
+			ArgType3 uniform _Lanes3[programCount];	\
+			_Lanes3[programIndex] = Arg3;	\
+			ArgType4 uniform _Lanes4[programCount];	\
+			_Lanes4[programIndex] = Arg4;	\
+			ArgType5 uniform _Lanes5[programCount];	\
+			_Lanes5[programIndex] = Arg5;	\
+			ArgType6 uniform _Lanes6[programCount];	\
+			_Lanes6[programIndex] = Arg6;	\
+			ArgType7 uniform _Lanes7[programCount];	\
+			_Lanes7[programIndex] = Arg7;	\
+			FuncName ## _CppGangCallback (lanemask(), _ReturnValues, _Lanes0, _Lanes1, _Lanes2, _Lanes3, _Lanes4, _Lanes5, _Lanes6, _Lanes7);	\
+			return _ReturnValues[programIndex];	\
+		}
+	#define DefineCppGangCallback_9Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, ArgType8, Arg8, CppCode)	\
+		inline ReturnType varying FuncName (ArgType0 varying Arg0, ArgType1 varying Arg1, ArgType2 varying Arg2, ArgType3 varying Arg3, ArgType4 varying Arg4, ArgType5 varying Arg5, ArgType6 varying Arg6, ArgType7 varying Arg7, ArgType8 varying Arg8)	\
+		{	\
+			extern "C" void FuncName ## _CppGangCallback (uniform int32 LaneMask, ReturnType uniform * uniform _ReturnValues, ArgType0 uniform * uniform _Lanes0, ArgType1 uniform * uniform _Lanes1, ArgType2 uniform * uniform _Lanes2, ArgType3 uniform * uniform _Lanes3, ArgType4 uniform * uniform _Lanes4, ArgType5 uniform * uniform _Lanes5, ArgType6 uniform * uniform _Lanes6, ArgType7 uniform * uniform _Lanes7, ArgType8 uniform * uniform _Lanes8);	\
+			ReturnType uniform _ReturnValues[programCount];	\
+			ArgType0 uniform _Lanes0[programCount];	\
+			_Lanes0[programIndex] = Arg0;	\
+			ArgType1 uniform _Lanes1[programCount];	\
+			_Lanes1[programIndex] = Arg1;	\
+			ArgType2 uniform _Lanes2[programCount];	\
+			_Lanes2[programIndex] = Arg2;	\
+			ArgType3 uniform _Lanes3[programCount];	\
+			_Lanes3[programIndex] = Arg3;	\
+			ArgType4 uniform _Lanes4[programCount];	\
+			_Lanes4[programIndex] = Arg4;	\
+			ArgType5 uniform _Lanes5[programCount];	\
+			_Lanes5[programIndex] = Arg5;	\
+			ArgType6 uniform _Lanes6[programCount];	\
+			_Lanes6[programIndex] = Arg6;	\
+			ArgType7 uniform _Lanes7[programCount];	\
+			_Lanes7[programIndex] = Arg7;	\
+			ArgType8 uniform _Lanes8[programCount];	\
+			_Lanes8[programIndex] = Arg8;	\
+			FuncName ## _CppGangCallback (lanemask(), _ReturnValues, _Lanes0, _Lanes1, _Lanes2, _Lanes3, _Lanes4, _Lanes5, _Lanes6, _Lanes7, _Lanes8);	\
+			return _ReturnValues[programIndex];	\
+		}
 #elif defined(EMIT_FORWARD_DECLARATIONS)
 	#ifdef DefineCppCallback_0Arg
 		#undef DefineCppCallback_0Arg
@@ -125,6 +450,66 @@
 	#ifdef DefineCppCallback_9Arg_RetVal
 		#undef DefineCppCallback_9Arg_RetVal
 	#endif
+	#ifdef DefineCppGangCallback_0Arg
+		#undef DefineCppGangCallback_0Arg
+	#endif
+	#ifdef DefineCppGangCallback_1Arg
+		#undef DefineCppGangCallback_1Arg
+	#endif
+	#ifdef DefineCppGangCallback_2Arg
+		#undef DefineCppGangCallback_2Arg
+	#endif
+	#ifdef DefineCppGangCallback_3Arg
+		#undef DefineCppGangCallback_3Arg
+	#endif
+	#ifdef DefineCppGangCallback_4Arg
+		#undef DefineCppGangCallback_4Arg
+	#endif
+	#ifdef DefineCppGangCallback_5Arg
+		#undef DefineCppGangCallback_5Arg
+	#endif
+	#ifdef DefineCppGangCallback_6Arg
+		#undef DefineCppGangCallback_6Arg
+	#endif
+	#ifdef DefineCppGangCallback_7Arg
+		#undef DefineCppGangCallback_7Arg
+	#endif
+	#ifdef DefineCppGangCallback_8Arg
+		#undef DefineCppGangCallback_8Arg
+	#endif
+	#ifdef DefineCppGangCallback_9Arg
+		#undef DefineCppGangCallback_9Arg
+	#endif
+	#ifdef DefineCppGangCallback_0Arg_RetVal
+		#undef DefineCppGangCallback_0Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_1Arg_RetVal
+		#undef DefineCppGangCallback_1Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_2Arg_RetVal
+		#undef DefineCppGangCallback_2Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_3Arg_RetVal
+		#undef DefineCppGangCallback_3Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_4Arg_RetVal
+		#undef DefineCppGangCallback_4Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_5Arg_RetVal
+		#undef DefineCppGangCallback_5Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_6Arg_RetVal
+		#undef DefineCppGangCallback_6Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_7Arg_RetVal
+		#undef DefineCppGangCallback_7Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_8Arg_RetVal
+		#undef DefineCppGangCallback_8Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_9Arg_RetVal
+		#undef DefineCppGangCallback_9Arg_RetVal
+	#endif
 	#define DefineCppCallback_0Arg(FuncName, CppCode)	\
 		extern "C" void FuncName ## _CppCallback();
 	#define DefineCppCallback_1Arg(FuncName, ArgType0, Arg0, CppCode)	\
@@ -165,6 +550,46 @@
 		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7);
 	#define DefineCppCallback_9Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, ArgType8, Arg8, CppCode)	\
 		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7, ArgType8 Arg8);
+	#define DefineCppGangCallback_0Arg(FuncName, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask);
+	#define DefineCppGangCallback_1Arg(FuncName, ArgType0, Arg0, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0);
+	#define DefineCppGangCallback_2Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1);
+	#define DefineCppGangCallback_3Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2);
+	#define DefineCppGangCallback_4Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3);
+	#define DefineCppGangCallback_5Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4);
+	#define DefineCppGangCallback_6Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5);
+	#define DefineCppGangCallback_7Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6);
+	#define DefineCppGangCallback_8Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6, ArgType7* _Lanes7);
+	#define DefineCppGangCallback_9Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, ArgType8, Arg8, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6, ArgType7* _Lanes7, ArgType8* _Lanes8);
+	#define DefineCppGangCallback_0Arg_RetVal(ReturnType, FuncName, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues);
+	#define DefineCppGangCallback_1Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0);
+	#define DefineCppGangCallback_2Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1);
+	#define DefineCppGangCallback_3Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2);
+	#define DefineCppGangCallback_4Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3);
+	#define DefineCppGangCallback_5Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4);
+	#define DefineCppGangCallback_6Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5);
+	#define DefineCppGangCallback_7Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6);
+	#define DefineCppGangCallback_8Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6, ArgType7* _Lanes7);
+	#define DefineCppGangCallback_9Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, ArgType8, Arg8, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6, ArgType7* _Lanes7, ArgType8* _Lanes8);
 #elif defined(EMIT_FRIEND_DECLARATIONS)
 	#ifdef DefineCppCallback_0Arg
 		#undef DefineCppCallback_0Arg
@@ -226,6 +651,66 @@
 	#ifdef DefineCppCallback_9Arg_RetVal
 		#undef DefineCppCallback_9Arg_RetVal
 	#endif
+	#ifdef DefineCppGangCallback_0Arg
+		#undef DefineCppGangCallback_0Arg
+	#endif
+	#ifdef DefineCppGangCallback_1Arg
+		#undef DefineCppGangCallback_1Arg
+	#endif
+	#ifdef DefineCppGangCallback_2Arg
+		#undef DefineCppGangCallback_2Arg
+	#endif
+	#ifdef DefineCppGangCallback_3Arg
+		#undef DefineCppGangCallback_3Arg
+	#endif
+	#ifdef DefineCppGangCallback_4Arg
+		#undef DefineCppGangCallback_4Arg
+	#endif
+	#ifdef DefineCppGangCallback_5Arg
+		#undef DefineCppGangCallback_5Arg
+	#endif
+	#ifdef DefineCppGangCallback_6Arg
+		#undef DefineCppGangCallback_6Arg
+	#endif
+	#ifdef DefineCppGangCallback_7Arg
+		#undef DefineCppGangCallback_7Arg
+	#endif
+	#ifdef DefineCppGangCallback_8Arg
+		#undef DefineCppGangCallback_8Arg
+	#endif
+	#ifdef DefineCppGangCallback_9Arg
+		#undef DefineCppGangCallback_9Arg
+	#endif
+	#ifdef DefineCppGangCallback_0Arg_RetVal
+		#undef DefineCppGangCallback_0Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_1Arg_RetVal
+		#undef DefineCppGangCallback_1Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_2Arg_RetVal
+		#undef DefineCppGangCallback_2Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_3Arg_RetVal
+		#undef DefineCppGangCallback_3Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_4Arg_RetVal
+		#undef DefineCppGangCallback_4Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_5Arg_RetVal
+		#undef DefineCppGangCallback_5Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_6Arg_RetVal
+		#undef DefineCppGangCallback_6Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_7Arg_RetVal
+		#undef DefineCppGangCallback_7Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_8Arg_RetVal
+		#undef DefineCppGangCallback_8Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_9Arg_RetVal
+		#undef DefineCppGangCallback_9Arg_RetVal
+	#endif
 	#define DefineCppCallback_0Arg(FuncName, CppCode)	\
 		friend void FuncName ## _CppCallback();
 	#define DefineCppCallback_1Arg(FuncName, ArgType0, Arg0, CppCode)	\
@@ -266,7 +751,54 @@
 		friend ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7);
 	#define DefineCppCallback_9Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, ArgType8, Arg8, CppCode)	\
 		friend ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7, ArgType8 Arg8);
+	#define DefineCppGangCallback_0Arg(FuncName, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask);
+	#define DefineCppGangCallback_1Arg(FuncName, ArgType0, Arg0, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0);
+	#define DefineCppGangCallback_2Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1);
+	#define DefineCppGangCallback_3Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2);
+	#define DefineCppGangCallback_4Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3);
+	#define DefineCppGangCallback_5Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4);
+	#define DefineCppGangCallback_6Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5);
+	#define DefineCppGangCallback_7Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6);
+	#define DefineCppGangCallback_8Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6, ArgType7* _Lanes7);
+	#define DefineCppGangCallback_9Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, ArgType8, Arg8, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6, ArgType7* _Lanes7, ArgType8* _Lanes8);
+	#define DefineCppGangCallback_0Arg_RetVal(ReturnType, FuncName, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues);
+	#define DefineCppGangCallback_1Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0);
+	#define DefineCppGangCallback_2Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1);
+	#define DefineCppGangCallback_3Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2);
+	#define DefineCppGangCallback_4Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3);
+	#define DefineCppGangCallback_5Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4);
+	#define DefineCppGangCallback_6Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5);
+	#define DefineCppGangCallback_7Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6);
+	#define DefineCppGangCallback_8Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6, ArgType7* _Lanes7);
+	#define DefineCppGangCallback_9Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, ArgType8, Arg8, CppCode)	\
+		friend void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6, ArgType7* _Lanes7, ArgType8* _Lanes8);
 #else
+	#ifndef CPP_GANG_CALLBACK_HELPERS
+	#define CPP_GANG_CALLBACK_HELPERS
+		template<typename T>
+		inline typename TEnableIf<TIsPointer<T>::Value>::Type CppGangPrefetch(T Ptr) { FPlatformMisc::Prefetch(Ptr); }
+		template<typename T>
+		inline typename TEnableIf<!TIsPointer<T>::Value>::Type CppGangPrefetch(const T&) {}
+	#endif
 	#ifdef DefineCppCallback_0Arg
 		#undef DefineCppCallback_0Arg
 	#endif
@@ -327,44 +859,476 @@
 	#ifdef DefineCppCallback_9Arg_RetVal
 		#undef DefineCppCallback_9Arg_RetVal
 	#endif
+	#ifdef DefineCppGangCallback_0Arg
+		#undef DefineCppGangCallback_0Arg
+	#endif
+	#ifdef DefineCppGangCallback_1Arg
+		#undef DefineCppGangCallback_1Arg
+	#endif
+	#ifdef DefineCppGangCallback_2Arg
+		#undef DefineCppGangCallback_2Arg
+	#endif
+	#ifdef DefineCppGangCallback_3Arg
+		#undef DefineCppGangCallback_3Arg
+	#endif
+	#ifdef DefineCppGangCallback_4Arg
+		#undef DefineCppGangCallback_4Arg
+	#endif
+	#ifdef DefineCppGangCallback_5Arg
+		#undef DefineCppGangCallback_5Arg
+	#endif
+	#ifdef DefineCppGangCallback_6Arg
+		#undef DefineCppGangCallback_6Arg
+	#endif
+	#ifdef DefineCppGangCallback_7Arg
+		#undef DefineCppGangCallback_7Arg
+	#endif
+	#ifdef DefineCppGangCallback_8Arg
+		#undef DefineCppGangCallback_8Arg
+	#endif
+	#ifdef DefineCppGangCallback_9Arg
+		#undef DefineCppGangCallback_9Arg
+	#endif
+	#ifdef DefineCppGangCallback_0Arg_RetVal
+		#undef DefineCppGangCallback_0Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_1Arg_RetVal
+		#undef DefineCppGangCallback_1Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_2Arg_RetVal
+		#undef DefineCppGangCallback_2Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_3Arg_RetVal
+		#undef DefineCppGangCallback_3Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_4Arg_RetVal
+		#undef DefineCppGangCallback_4Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_5Arg_RetVal
+		#undef DefineCppGangCallback_5Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_6Arg_RetVal
+		#undef DefineCppGangCallback_6Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_7Arg_RetVal
+		#undef DefineCppGangCallback_7Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_8Arg_RetVal
+		#undef DefineCppGangCallback_8Arg_RetVal
+	#endif
+	#ifdef DefineCppGangCallback_9Arg_RetVal
+		#undef DefineCppGangCallback_9Arg_RetVal
+	#endif
 	#define DefineCppCallback_0Arg(FuncName, CppCode)	\
-		extern "C" void FuncName ## _CppCallback() CppCode
+		extern "C" void FuncName ## _CppCallback()	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_1Arg(FuncName, ArgType0, Arg0, CppCode)	\
-		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0) CppCode
+		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_2Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, CppCode)	\
-		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1) CppCode
+		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_3Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, CppCode)	\
-		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2) CppCode
+		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_4Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, CppCode)	\
-		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3) CppCode
+		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_5Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, CppCode)	\
-		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4) CppCode
+		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_6Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, CppCode)	\
-		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5) CppCode
+		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_7Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, CppCode)	\
-		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6) CppCode
+		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_8Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, CppCode)	\
-		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7) CppCode
+		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_9Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, ArgType8, Arg8, CppCode)	\
-		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7, ArgType8 Arg8) CppCode
+		extern "C" void FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7, ArgType8 Arg8)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_0Arg_RetVal(ReturnType, FuncName, CppCode)	\
-		extern "C" ReturnType FuncName ## _CppCallback() CppCode
+		extern "C" ReturnType FuncName ## _CppCallback()	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_1Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, CppCode)	\
-		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0) CppCode
+		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_2Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, CppCode)	\
-		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1) CppCode
+		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_3Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, CppCode)	\
-		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2) CppCode
+		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_4Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, CppCode)	\
-		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3) CppCode
+		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_5Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, CppCode)	\
-		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4) CppCode
+		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_6Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, CppCode)	\
-		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5) CppCode
+		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_7Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, CppCode)	\
-		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6) CppCode
+		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_8Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, CppCode)	\
-		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7) CppCode
+		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
 	#define DefineCppCallback_9Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, ArgType8, Arg8, CppCode)	\
-		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7, ArgType8 Arg8) CppCode
+		extern "C" ReturnType FuncName ## _CppCallback(ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7, ArgType8 Arg8)	\
+		{	\
+			FCppCallbackCounters::RecordLaneCall();	\
+			CppCode	\
+		}
+	#define DefineCppGangCallback_0Arg(FuncName, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&]() CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_PerLane();	\
+			}	\
+		}
+	#define DefineCppGangCallback_1Arg(FuncName, ArgType0, Arg0, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0) CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_PerLane(_Lanes0[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_2Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1) CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_PerLane(_Lanes0[_Lane], _Lanes1[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_3Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2) CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_PerLane(_Lanes0[_Lane], _Lanes1[_Lane], _Lanes2[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_4Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3) CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_PerLane(_Lanes0[_Lane], _Lanes1[_Lane], _Lanes2[_Lane], _Lanes3[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_5Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4) CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_PerLane(_Lanes0[_Lane], _Lanes1[_Lane], _Lanes2[_Lane], _Lanes3[_Lane], _Lanes4[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_6Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5) CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_PerLane(_Lanes0[_Lane], _Lanes1[_Lane], _Lanes2[_Lane], _Lanes3[_Lane], _Lanes4[_Lane], _Lanes5[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_7Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6) CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_PerLane(_Lanes0[_Lane], _Lanes1[_Lane], _Lanes2[_Lane], _Lanes3[_Lane], _Lanes4[_Lane], _Lanes5[_Lane], _Lanes6[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_8Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6, ArgType7* _Lanes7)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7) CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_PerLane(_Lanes0[_Lane], _Lanes1[_Lane], _Lanes2[_Lane], _Lanes3[_Lane], _Lanes4[_Lane], _Lanes5[_Lane], _Lanes6[_Lane], _Lanes7[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_9Arg(FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, ArgType8, Arg8, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6, ArgType7* _Lanes7, ArgType8* _Lanes8)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7, ArgType8 Arg8) CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_PerLane(_Lanes0[_Lane], _Lanes1[_Lane], _Lanes2[_Lane], _Lanes3[_Lane], _Lanes4[_Lane], _Lanes5[_Lane], _Lanes6[_Lane], _Lanes7[_Lane], _Lanes8[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_0Arg_RetVal(ReturnType, FuncName, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&]() -> ReturnType CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_ReturnValues[_Lane] = _PerLane();	\
+			}	\
+		}
+	#define DefineCppGangCallback_1Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0) -> ReturnType CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_ReturnValues[_Lane] = _PerLane(_Lanes0[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_2Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1) -> ReturnType CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_ReturnValues[_Lane] = _PerLane(_Lanes0[_Lane], _Lanes1[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_3Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2) -> ReturnType CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_ReturnValues[_Lane] = _PerLane(_Lanes0[_Lane], _Lanes1[_Lane], _Lanes2[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_4Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3) -> ReturnType CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_ReturnValues[_Lane] = _PerLane(_Lanes0[_Lane], _Lanes1[_Lane], _Lanes2[_Lane], _Lanes3[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_5Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4) -> ReturnType CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_ReturnValues[_Lane] = _PerLane(_Lanes0[_Lane], _Lanes1[_Lane], _Lanes2[_Lane], _Lanes3[_Lane], _Lanes4[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_6Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5) -> ReturnType CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_ReturnValues[_Lane] = _PerLane(_Lanes0[_Lane], _Lanes1[_Lane], _Lanes2[_Lane], _Lanes3[_Lane], _Lanes4[_Lane], _Lanes5[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_7Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6) -> ReturnType CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_ReturnValues[_Lane] = _PerLane(_Lanes0[_Lane], _Lanes1[_Lane], _Lanes2[_Lane], _Lanes3[_Lane], _Lanes4[_Lane], _Lanes5[_Lane], _Lanes6[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_8Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6, ArgType7* _Lanes7)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7) -> ReturnType CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_ReturnValues[_Lane] = _PerLane(_Lanes0[_Lane], _Lanes1[_Lane], _Lanes2[_Lane], _Lanes3[_Lane], _Lanes4[_Lane], _Lanes5[_Lane], _Lanes6[_Lane], _Lanes7[_Lane]);	\
+			}	\
+		}
+	#define DefineCppGangCallback_9Arg_RetVal(ReturnType, FuncName, ArgType0, Arg0, ArgType1, Arg1, ArgType2, Arg2, ArgType3, Arg3, ArgType4, Arg4, ArgType5, Arg5, ArgType6, Arg6, ArgType7, Arg7, ArgType8, Arg8, CppCode)	\
+		extern "C" void FuncName ## _CppGangCallback(int32 LaneMask, ReturnType* _ReturnValues, ArgType0* _Lanes0, ArgType1* _Lanes1, ArgType2* _Lanes2, ArgType3* _Lanes3, ArgType4* _Lanes4, ArgType5* _Lanes5, ArgType6* _Lanes6, ArgType7* _Lanes7, ArgType8* _Lanes8)	\
+		{	\
+			FCppCallbackCounters::RecordGangCall(LaneMask);	\
+			auto _PerLane = [&](ArgType0 Arg0, ArgType1 Arg1, ArgType2 Arg2, ArgType3 Arg3, ArgType4 Arg4, ArgType5 Arg5, ArgType6 Arg6, ArgType7 Arg7, ArgType8 Arg8) -> ReturnType CppCode;	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				CppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);	\
+			}	\
+			for (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)	\
+			{	\
+				const int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);	\
+				_ReturnValues[_Lane] = _PerLane(_Lanes0[_Lane], _Lanes1[_Lane], _Lanes2[_Lane], _Lanes3[_Lane], _Lanes4[_Lane], _Lanes5[_Lane], _Lanes6[_Lane], _Lanes7[_Lane], _Lanes8[_Lane]);	\
+			}	\
+		}
 #endif
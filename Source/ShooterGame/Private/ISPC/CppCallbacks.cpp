@@ -1,7 +1,11 @@
 #include "ShooterGame.h"
 #include "Bots/ShooterUnrolledCppMovement.h"
 
+#include "Async/ParallelFor.h"
 #include "CppInterop.h"
+#include "CppCallbackCounters.h"
+#include "Bots/ShooterParallelMovement.h"
+#include "Bots/ShooterMovementEvents.h"
 
 // Also use this file to verify some assumptions about type equivalence.
 #include "ShooterISPCMovementSystem.ispc.h"
@@ -26,5 +30,89 @@ static_assert(offsetof(ispc::FHitResult, Component) == offsetof(FHitResult, Comp
 static_assert(offsetof(ispc::FHitResult, BoneName) == offsetof(FHitResult, BoneName), "Type binary layouts don't match");
 static_assert(offsetof(ispc::FHitResult, MyBoneName) == offsetof(FHitResult, MyBoneName), "Type binary layouts don't match");
 static_assert(sizeof(ispc::FHitResult) == sizeof(FHitResult), "Type sizes don't match");
+static_assert(sizeof(ispc::FFindFloorResult) == sizeof(FFindFloorResult), "Type sizes don't match");
+static_assert(sizeof(ispc::FISPCMovementArrays) == sizeof(FISPCMovementArrays), "Type sizes don't match");
+static_assert(sizeof(ispc::FISPCPhysicsQueue) == sizeof(FISPCPhysicsQueue), "Type sizes don't match");
+static_assert(sizeof(ispc::FCollisionQueryRequest) == sizeof(FCollisionQueryRequest), "Type sizes don't match");
+static_assert(offsetof(ispc::FCollisionQueryRequest, CollisionShape) == offsetof(FCollisionQueryRequest, CollisionShape), "Type binary layouts don't match");
+static_assert(offsetof(ispc::FCollisionQueryRequest, TraceChannel) == offsetof(FCollisionQueryRequest, TraceChannel), "Type binary layouts don't match");
+
+bool FCppCallbackCounters::bEnabled = false;
+volatile int64 FCppCallbackCounters::LaneCalls = 0;
+volatile int64 FCppCallbackCounters::GangCalls = 0;
+volatile int64 FCppCallbackCounters::GangActiveLanes = 0;
 
 #include "CppCallbacks.inl"
+
+static TAutoConsoleVariable<int32> CVarISPCCollisionBatchParallelThreshold(
+	TEXT("ispc.CollisionBatchParallelThreshold"),
+	0,
+	TEXT("Minimum number of requests in a batched scene query from the ISPC kernel for it to be resolved with a ParallelFor.\n")
+	TEXT("0 (default): always resolve serially on the calling thread"),
+	ECVF_Default
+);
+
+namespace
+{
+	template<typename FuncType>
+	void ResolveCollisionBatch(int32 Count, const FuncType& Func)
+	{
+		// Scene queries only take the physics scene read lock, so requests can be resolved concurrently.
+		const int32 ParallelThreshold = CVarISPCCollisionBatchParallelThreshold.GetValueOnAnyThread();
+		if (ParallelThreshold > 0 && Count >= ParallelThreshold)
+		{
+			ParallelFor(Count, Func);
+		}
+		else
+		{
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				Func(Index);
+			}
+		}
+	}
+}
+
+// ISPC: Batched counterparts of SweepSingleByChannel/OverlapBlockingTestByChannel. Thread-safe.
+// All requests in a batch come from the same world, so the world is looked up once.
+extern "C" void SweepSingleByChannelBatch_CppCallback(const FCollisionQueryRequest* Requests, /*FHitResult**/void* _OutHits, bool* OutBlockingHits, int32 Count)
+{
+	if (Count <= 0)
+	{
+		return;
+	}
+	FCppCallbackCounters::RecordBatch(Count);
+
+	UWorld* World = ((const UShooterUnrolledCppMovement*)Requests[0].Comp)->GetWorld();
+	FHitResult* OutHits = static_cast<FHitResult*>(_OutHits);
+	ResolveCollisionBatch(Count, [&](int32 Index)
+	{
+		const FCollisionQueryRequest& Request = Requests[Index];
+		OutBlockingHits[Index] = World->SweepSingleByChannel(
+			OutHits[Index],
+			Request.Start, Request.End, Request.Rot, (ECollisionChannel)Request.TraceChannel,
+			Request.CollisionShape,
+			*((const FCollisionQueryParams*)Request.Params),
+			*((const FCollisionResponseParams*)Request.ResponseParam));
+	});
+}
+
+extern "C" void OverlapBlockingTestByChannelBatch_CppCallback(const FCollisionQueryRequest* Requests, bool* OutBlockingHits, int32 Count)
+{
+	if (Count <= 0)
+	{
+		return;
+	}
+	FCppCallbackCounters::RecordBatch(Count);
+
+	UWorld* World = ((const UShooterUnrolledCppMovement*)Requests[0].Comp)->GetWorld();
+	ResolveCollisionBatch(Count, [&](int32 Index)
+	{
+		const FCollisionQueryRequest& Request = Requests[Index];
+		OutBlockingHits[Index] = World->OverlapBlockingTestByChannel(
+			Request.Start, Request.Rot, (ECollisionChannel)Request.TraceChannel,
+			Request.CollisionShape,
+			*((const FCollisionQueryParams*)Request.Params),
+			*((const FCollisionResponseParams*)Request.ResponseParam));
+	});
+}
@@ -1,5 +1,17 @@
 #include "CppCallbackMacros.h"
 
+// ISPC: With a parallel movement tick (ispc.MovementChunkSize > 0), these callbacks run on task graph
+// worker threads. Each of them falls into one of two categories:
+// - Thread-safe: only reads engine state, runs scene queries (which take the physics scene read lock),
+//   or writes state owned exclusively by the calling lane's component or character.
+// - Game thread only: touches shared engine state (transforms, overlaps, physics bodies, delegates, the
+//   net driver). The body is wrapped in RunOnGameThread(), which executes it directly on the game thread
+//   and otherwise marshals it there and blocks until it has run.
+// New callbacks must be wrapped in RunOnGameThread() unless they clearly satisfy the first category.
+//
+// Cheap, frequently called getters use the gang flavour (DefineCppGangCallback_*), which makes one call
+// per gang with all active lanes' arguments instead of one call per lane.
+
 #ifdef ISPC
 	#define Marshalled_FVector	FVector
 #else
@@ -17,19 +29,12 @@ DefineCppCallback_2Arg(ConsumeRootMotion,
 		Comp->CurrentRootMotion.Clear();
 	})
 
-DefineCppCallback_1Arg_RetVal(bool, IsPendingKill,
+DefineCppGangCallback_1Arg_RetVal(bool, IsPendingKill,
 	const void*, _Obj,
 	{
 		return static_cast<const UObject*>(_Obj)->IsPendingKill();
 	})
 
-DefineCppCallback_1Arg_RetVal(Marshalled_FVector, GetUpdatedComponentLocation,
-	const void*, _Comp,
-	{
-		FVector Result = AccessComp->UpdatedComponent->GetComponentLocation();
-		return *reinterpret_cast<ispc::float3*>(&Result);
-	})
-
 DefineCppCallback_2Arg(SetCharacterOwner_bIsCrouched,
 	const void*, _Comp, const bool, bValue,
 	{
@@ -39,38 +44,38 @@ DefineCppCallback_2Arg(SetCharacterOwner_bIsCrouched,
 DefineCppCallback_3Arg(CharacterOwner_OnStartCrouch,
 	const void*, _Comp, const float, HeightAdjust, const float, ScaledHeightAdjust,
 	{
-		AccessComp->CharacterOwner->OnStartCrouch(HeightAdjust, ScaledHeightAdjust);
+		// Game thread only.
+		return RunOnGameThread([&]()
+		{
+			AccessComp->CharacterOwner->OnStartCrouch(HeightAdjust, ScaledHeightAdjust);
+		});
 	})
 
 DefineCppCallback_1Arg(RestoreDefaultCapsuleSize,
 	const void*, _CharacterOwner,
 	{
-		auto* CharacterOwner = (ACharacter*)_CharacterOwner;
-		ACharacter* DefaultCharacter = CharacterOwner->GetClass()->GetDefaultObject<ACharacter>();
-		CharacterOwner->GetCapsuleComponent()->SetCapsuleSize(
-			DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleRadius(),
-			DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight());
+		// Game thread only.
+		return RunOnGameThread([&]()
+		{
+			auto* CharacterOwner = (ACharacter*)_CharacterOwner;
+			ACharacter* DefaultCharacter = CharacterOwner->GetClass()->GetDefaultObject<ACharacter>();
+			CharacterOwner->GetCapsuleComponent()->SetCapsuleSize(
+				DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleRadius(),
+				DefaultCharacter->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight());
+		});
 	})
 
 DefineCppCallback_3Arg(SetCapsuleSize,
 	const void*, _CharacterOwner, float, Radius, float, HalfHeight,
 	{
-		auto* CharacterOwner = (ACharacter*)_CharacterOwner;
-		CharacterOwner->GetCapsuleComponent()->SetCapsuleSize(Radius, HalfHeight);
+		// Game thread only.
+		return RunOnGameThread([&]()
+		{
+			auto* CharacterOwner = (ACharacter*)_CharacterOwner;
+			CharacterOwner->GetCapsuleComponent()->SetCapsuleSize(Radius, HalfHeight);
+		});
 	})
 
-DefineCppCallback_5Arg(UpdatedPrimitive_InitSweepCollisionParams,
-	const void*, _UpdatedPrimitive, FName, InTraceTag, const void*, _InIgnoreActor,
-	void*, _OutParams, void*, _OutResponseParam,
-	{
-		// FIXME: Trace tag?
-		FName TraceTag = NAME_None;
-		FCollisionQueryParams* Query = new (_OutParams) FCollisionQueryParams(TraceTag, false, (AActor*)_InIgnoreActor);
-		FCollisionResponseParams* Response = new (_OutResponseParam) FCollisionResponseParams();
-		((UPrimitiveComponent*)_UpdatedPrimitive)->InitSweepCollisionParams(
-			*Query, *Response);
-	});
-
 DefineCppCallback_7Arg_RetVal(bool, OverlapBlockingTestByChannel,
 	const void*, _Comp, const FVector, Pos, const FQuat, Rot,
 	/*ECollisionChannel*/uint8, TraceChannel, const void*, _CollisionShape,
@@ -97,28 +102,46 @@ DefineCppCallback_9Arg_RetVal(bool, SweepSingleByChannel,
 			*((FCollisionResponseParams*)_ResponseParam));
 	})
 
-DefineCppCallback_7Arg_RetVal(bool, MoveComponent,
+DefineCppCallback_9Arg_RetVal(bool, MoveComponent,
 	const void*, _Comp, const FVector, Delta, const FQuat, NewRotation, bool, bSweep, /*FHitResult**/void*, _Hit, /*EMoveComponentFlags*/uint8, MoveFlags, /*ETeleportType*/uint8, Teleport,
+	/*FVector**/void*, _OutLocation, /*FQuat**/void*, _OutQuat,
 	{
-		return ((USceneComponent*)_Comp)->MoveComponent(
-			Delta,
-			NewRotation,
-			bSweep,
-			static_cast<FHitResult*>(_Hit),
-			(EMoveComponentFlags)MoveFlags,
-			(ETeleportType)Teleport);
+		// Game thread only.
+		return RunOnGameThread([&]()
+		{
+			USceneComponent* Comp = (USceneComponent*)_Comp;
+			const bool bMoved = Comp->MoveComponent(
+				Delta,
+				NewRotation,
+				bSweep,
+				static_cast<FHitResult*>(_Hit),
+				(EMoveComponentFlags)MoveFlags,
+				(ETeleportType)Teleport);
+			// Refresh the kernel's transform snapshot.
+			*static_cast<FVector*>(_OutLocation) = Comp->GetComponentLocation();
+			*static_cast<FQuat*>(_OutQuat) = Comp->GetComponentQuat();
+			return bMoved;
+		});
 	})
 
 DefineCppCallback_3Arg(OnStartCrouch,
 	const void*, _CharacterOwner, float, HeightAdjust, float, ScaledHeightAdjust,
 	{
-		((ACharacter*)_CharacterOwner)->OnStartCrouch(HeightAdjust, ScaledHeightAdjust);
+		// Game thread only.
+		return RunOnGameThread([&]()
+		{
+			((ACharacter*)_CharacterOwner)->OnStartCrouch(HeightAdjust, ScaledHeightAdjust);
+		});
 	})
 
 DefineCppCallback_3Arg(OnEndCrouch,
 	const void*, _CharacterOwner, float, HeightAdjust, float, ScaledHeightAdjust,
 	{
-		((ACharacter*)_CharacterOwner)->OnEndCrouch(HeightAdjust, ScaledHeightAdjust);
+		// Game thread only.
+		return RunOnGameThread([&]()
+		{
+			((ACharacter*)_CharacterOwner)->OnEndCrouch(HeightAdjust, ScaledHeightAdjust);
+		});
 	})
 
 DefineCppCallback_2Arg(MakeCapsuleCollisionShape,
@@ -140,47 +163,59 @@ DefineCppCallback_2Arg_RetVal(float, MaybeModifyWalkableFloorZ,
 		const UPrimitiveComponent* HitComponent = Cast<UPrimitiveComponent>(HitObject.Get());
 		if (HitComponent)
 		{
+			// Only reached for components the walkable slope table doesn't have yet, see ModifyWalkableFloorZ().
+			if (FWalkableSlopeTable::Active)
+			{
+				FWalkableSlopeTable::Active->AddPending(HitComponent);
+			}
 			const FWalkableSlopeOverride& SlopeOverride = HitComponent->GetWalkableSlopeOverride();
 			return SlopeOverride.ModifyWalkableFloorZ(TestWalkableZ);
 		}
 		return TestWalkableZ;
 	})
 
-DefineCppCallback_4Arg(OnCharacterMovementUpdated,
-	const void*, _CharacterOwner, float, DeltaTime, const FVector, OldLocation, const FVector, OldVelocity,
+DefineCppCallback_5Arg(OnCharacterMovementUpdated,
+	const void*, _Comp, const void*, _CharacterOwner, float, DeltaTime, const FVector, OldLocation, const FVector, OldVelocity,
 	{
-		((ACharacter*)_CharacterOwner)->OnCharacterMovementUpdated.Broadcast(DeltaTime, OldLocation, OldVelocity);
+		// Thread-safe while the system's movement event queue is active, game thread only otherwise.
+		const bool bQueued = FMovementEventQueue::TryQueue(EMovementEventType::MovementUpdated, AccessComp, AccessComp->SystemIndex, (ACharacter*)_CharacterOwner, [&](FMovementEvent& Event)
+		{
+			Event.Time = DeltaTime;
+			Event.Location = OldLocation;
+			Event.Velocity = OldVelocity;
+		});
+		if (bQueued)
+		{
+			return;
+		}
+		return RunOnGameThread([&]()
+		{
+			((ACharacter*)_CharacterOwner)->OnCharacterMovementUpdated.Broadcast(DeltaTime, OldLocation, OldVelocity);
+		});
 	})
 
 DefineCppCallback_1Arg(CancelAdaptiveReplication,
 	const void*, _Comp,
 	{
-		const UWorld* MyWorld = AccessComp->GetWorld();
-		if (MyWorld)
+		// Game thread only.
+		return RunOnGameThread([&]()
 		{
-			UNetDriver* NetDriver = MyWorld->GetNetDriver();
-			if (NetDriver && NetDriver->IsServer())
+			const UWorld* MyWorld = AccessComp->GetWorld();
+			if (MyWorld)
 			{
-				FNetworkObjectInfo* NetActor = NetDriver->FindOrAddNetworkObjectInfo(AccessComp->CharacterOwner);
-
-				if (NetActor && MyWorld->GetTimeSeconds() <= NetActor->NextUpdateTime && NetDriver->IsNetworkActorUpdateFrequencyThrottled(*NetActor))
+				UNetDriver* NetDriver = MyWorld->GetNetDriver();
+				if (NetDriver && NetDriver->IsServer())
 				{
-					if (AccessComp->ShouldCancelAdaptiveReplication())
+					FNetworkObjectInfo* NetActor = NetDriver->FindOrAddNetworkObjectInfo(AccessComp->CharacterOwner);
+
+					if (NetActor && MyWorld->GetTimeSeconds() <= NetActor->NextUpdateTime && NetDriver->IsNetworkActorUpdateFrequencyThrottled(*NetActor))
 					{
-						NetDriver->CancelAdaptiveReplication(*NetActor);
+						if (AccessComp->ShouldCancelAdaptiveReplication())
+						{
+							NetDriver->CancelAdaptiveReplication(*NetActor);
+						}
 					}
 				}
 			}
-		}
-	})
-
-DefineCppCallback_1Arg_RetVal(float, GetPhysicsVolume_GetGravityZ,
-	const void*, _MoveComp,
-	{
-		auto* MoveComp = (UCharacterMovementComponent*)_MoveComp;
-		if (MoveComp->UpdatedComponent)
-		{
-			return MoveComp->UpdatedComponent->GetPhysicsVolume()->GetGravityZ();
-		}
-		return MoveComp->GetWorld()->GetDefaultPhysicsVolume()->GetGravityZ();
-	})
\ No newline at end of file
+		});
+	})
\ No newline at end of file
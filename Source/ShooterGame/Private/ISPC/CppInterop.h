@@ -15,11 +15,34 @@
 
 #include "UnrealTypesForISPC.h"
 
+// Walkable slope overrides of hit components, see FWalkableSlopeTable. Open-addressed, keyed by FWeakObjectPtr.
+struct FISPCWalkableSlopeTable
+{
+	const int32* ObjectIndex;	// INDEX_NONE in empty slots
+	const int32* SerialNumber;
+	const FVector2D* Bounds;	// The override clamps the walkable floor Z to [x, y]
+	uint32 Mask;	// Capacity - 1
+};
+
+// Scene query call sites that keep their own trace tag, see FPooledCollisionParams.
+enum EBotQuerySite
+{
+	BQS_ComputeFloorDist,
+	BQS_FloorLineTrace,
+	BQS_CheckLedgeDirection,
+	BQS_CrouchTrace,
+	BQS_MovementOverlapTest,
+	BQS_MAX,
+};
+
 // The primary type we're working with.
 struct FISPCMovementArrays
 {
 	const bool UNetDriver_IsAdaptiveNetUpdateFrequencyEnabled;
 	const float WorldTimeSeconds;
+	const /*FCollisionResponseParams**/void* const DefaultResponseParam;	// &FCollisionResponseParams::DefaultResponseParam
+	const uint32 CollisionQueryParamsStride;	// sizeof(FCollisionQueryParams)
+	const FISPCWalkableSlopeTable WalkableSlopes;
 
 	// The Unreal objects. Intentionally opaque, only used for calls back into C++.
 	const /*UShooterUnrolledCppMovement**/void* const* Comp;
@@ -29,6 +52,10 @@ struct FISPCMovementArrays
 	const /*ACharacter**/void* const* CharacterOwner;
 	const /*UPrimitiveComponent**/void* const* CharacterOwner_MovementBase;
 	const /*AActor**/void* const* UpdatedComponent_Owner;
+	// Handles to the bot's entry in UShooterUnrolledCppMovementSystem::CollisionParamsPool, passed back to C++ by scene queries.
+	// The query params handle is the first of BQS_MAX, CollisionQueryParamsStride apart.
+	const /*FCollisionQueryParams**/void* const* CollisionQueryParams;
+	const /*FCollisionResponseParams**/void* const* CollisionResponseParams;
 
 	const
 #ifdef ISPC
@@ -63,12 +90,38 @@ struct FISPCMovementArrays
 	const int32* const MaxSimulationIterations;
 	const EMoveComponentFlags* const MoveComponentFlags;
 
-	FFindFloorResult* CurrentFloor;
+	// Per-frame snapshot, gathered up front so that the kernel doesn't need to call back into C++ for it.
+	const FVector* const UpdatedComponent_ComponentScale;
+	const float* const WalkableFloorZ;
+	const bool* const bScalarFallback;	// Mode not in GetKernelMovementModes(), the system moves the bot in C++ instead
+
+	// Physics volume snapshot, not gathered. Written on volume changes by UpdatePhysicsVolumeSnapshot(), also when a
+	// move made by the kernel enters a new volume.
+	const float* const PhysicsVolume_GravityZ;	// Comp->GetPhysicsVolume()->GetGravityZ(), GravityScale not applied
+	const bool* const PhysicsVolume_bWaterVolume;
+	const float* const PhysicsVolume_FluidFriction;
+	const float* const PhysicsVolume_TerminalVelocity;
+
+	// CurrentFloor, split hot/cold. The kernel reads the hot fields with unit stride; the rest of the record (hit
+	// actor, component, bone, physical material, trace data) lives in CurrentFloor_Cold and is only touched when a
+	// full FFindFloorResult is needed, see LoadCurrentFloor()/StoreCurrentFloor(). The hot fields' copies in
+	// CurrentFloor_Cold are stale.
+	bool* CurrentFloor_bBlockingHit;
+	bool* CurrentFloor_bWalkableFloor;
+	bool* CurrentFloor_bLineTrace;
+	float* CurrentFloor_FloorDist;
+	float* CurrentFloor_LineDist;
+	float* CurrentFloor_Time;	// HitResult.Time
+	FVector* CurrentFloor_ImpactPoint;	// HitResult.ImpactPoint
+	FVector* CurrentFloor_ImpactNormal;	// HitResult.ImpactNormal
+	FFindFloorResult* CurrentFloor_Cold;
+	bool* CurrentFloor_bColdDirty;	// Set by StoreCurrentFloor(), the scatter then copies the whole record
 	
 	EMovementMode* MovementMode;
 	bool* CharacterOwner_bIsCrouched;
 	FVector* const CharacterOwner_CapsuleComponent_Size;	// x = Radius, y = HalfHeight, z = ShapeScale
 	FQuat* const UpdatedComponent_ComponentQuat;
+	FVector* const UpdatedComponent_ComponentLocation;	// Kept in sync with the component by MoveComponent()
 
 	FVector* PendingImpulseToApply;
 	FVector* PendingForceToApply;
@@ -89,3 +142,32 @@ struct FISPCMovementArrays
 
 	float* ServerLastTransformUpdateTimeStamp;
 };
+
+// Per-frame state of the bucketed tick, carried from PrePhysics() through the per-mode kernels to PostPhysics().
+struct FISPCPhysicsQueue
+{
+	FVector* OldLocation;
+	FVector* OldVelocity;
+	bool* bPerformMovement;
+	// Time slice and iteration count the next StartNewPhysics() call resumes with.
+	float* RemainingTime;
+	int32* Iterations;
+	// Set by StartNewPhysics() when the movement mode changed and the bot needs to move to another bucket.
+	bool* bRequeued;
+};
+
+// One scene query staged by the kernel. A gang writes its active lanes' requests into a contiguous buffer
+// which is then resolved by a single call into C++ (see SweepSingleByChannelBatch_CppCallback()).
+struct FCollisionQueryRequest
+{
+	FQuat Rot;
+	FVector Start;
+	FVector End;	// Unused by overlap tests.
+	FCollisionShape CollisionShape;
+	const /*UShooterUnrolledCppMovement**/void* Comp;
+	const /*FCollisionQueryParams**/void* Params;
+	const /*FCollisionResponseParams**/void* ResponseParam;
+	/*ECollisionChannel*/uint8 TraceChannel;
+	// FQuat is 16-byte aligned on the C++ side only; pad explicitly so that both sides agree on the size.
+	uint8 _Padding[15];
+};
@@ -33,7 +33,47 @@ def EmitCallbackMacrosISPCSide(bUseReturnType):
 			ArgDeclUniform,
 			ArgFwd))
 
-def EmitCallbackMacrosUndefsCppSide(bUseReturnType):
+def EmitGangCallbackMacrosISPCSide(bUseReturnType):
+	for Count in range(VariantCount):
+		MacroArgs = ''
+		ArgDeclVarying = '('
+		ArgDeclGang = '(uniform int32 LaneMask'
+		ArgStore = ''
+		ArgFwd = '(lanemask()'
+		if bUseReturnType:
+			ArgDeclGang += ', ReturnType uniform * uniform _ReturnValues'
+			ArgFwd += ', _ReturnValues'
+		for Index in range(Count):
+			MacroArgs += 'ArgType{0}, Arg{0}, '.format(Index)
+			ArgDeclVarying += 'ArgType{0} varying Arg{0}'.format(Index)
+			ArgDeclGang += ', ArgType{0} uniform * uniform _Lanes{0}'.format(Index)
+			ArgStore += '\t\t\tArgType{0} uniform _Lanes{0}[programCount];\t\\\n\t\t\t_Lanes{0}[programIndex] = Arg{0};\t\\\n'.format(Index)
+			ArgFwd += ', _Lanes{0}'.format(Index)
+			if Index != Count - 1:
+				ArgDeclVarying += ', '
+		ArgDeclVarying += ')'
+		ArgDeclGang += ')'
+		ArgFwd += ')'
+		File.write(r'''	#define DefineCppGangCallback_{0}Arg{1}({2}FuncName, {3}CppCode)	\
+		inline {4} FuncName {5}	\
+		{{	\
+			extern "C" void FuncName ## _CppGangCallback {6};	\
+{7}{8}			FuncName ## _CppGangCallback {9};	\
+{10}		}}
+'''.format(
+			Count,
+			'_RetVal' if bUseReturnType else '',
+			'ReturnType, ' if bUseReturnType else '',
+			MacroArgs,
+			'ReturnType varying' if bUseReturnType else 'void',
+			ArgDeclVarying,
+			ArgDeclGang,
+			'\t\t\tReturnType uniform _ReturnValues[programCount];\t\\\n' if bUseReturnType else '',
+			ArgStore,
+			ArgFwd,
+			'\t\t\treturn _ReturnValues[programIndex];\t\\\n' if bUseReturnType else ''))
+
+def EmitCallbackMacrosUndefsCppSide(bUseReturnType, bGang = False):
 	for Count in range(VariantCount):
 		MacroArgs = ''
 		ArgDecl = ''
@@ -43,12 +83,13 @@ def EmitCallbackMacrosUndefsCppSide(bUseReturnType):
 			if Index != Count - 1:
 				ArgDecl += ', '
 		ArgDecl += ''
-		File.write(r'''	#ifdef DefineCppCallback_{0}Arg{1}
-		#undef DefineCppCallback_{0}Arg{1}
+		File.write(r'''	#ifdef DefineCpp{2}Callback_{0}Arg{1}
+		#undef DefineCpp{2}Callback_{0}Arg{1}
 	#endif
 '''.format(
 			Count,
-			'_RetVal' if bUseReturnType else ''))
+			'_RetVal' if bUseReturnType else '',
+			'Gang' if bGang else ''))
 
 def EmitCallbackMacrosCppSide(bUseReturnType, bFriend, bDeclarations):
 	for Count in range(VariantCount):
@@ -70,7 +111,59 @@ def EmitCallbackMacrosCppSide(bUseReturnType, bFriend, bDeclarations):
 			'friend' if bFriend else 'extern "C"',
 			'ReturnType' if bUseReturnType else 'void',
 			ArgDecl,
-			';' if bDeclarations else ' CppCode'))
+			';' if bDeclarations else '\t\\\n\t\t{\t\\\n\t\t\tFCppCallbackCounters::RecordLaneCall();\t\\\n\t\t\tCppCode\t\\\n\t\t}'))
+
+def EmitGangCallbackMacrosCppSide(bUseReturnType, bFriend, bDeclarations):
+	for Count in range(VariantCount):
+		MacroArgs = ''
+		ArgDecl = ''
+		GangArgDecl = 'int32 LaneMask'
+		LaneFwd = ''
+		if bUseReturnType:
+			GangArgDecl += ', ReturnType* _ReturnValues'
+		for Index in range(Count):
+			MacroArgs += 'ArgType{0}, Arg{0}, '.format(Index)
+			ArgDecl += 'ArgType{0} Arg{0}'.format(Index)
+			GangArgDecl += ', ArgType{0}* _Lanes{0}'.format(Index)
+			LaneFwd += '_Lanes{0}[_Lane]'.format(Index)
+			if Index != Count - 1:
+				ArgDecl += ', '
+				LaneFwd += ', '
+		if bDeclarations:
+			Body = ';'
+		else:
+			# The callback body becomes a lambda invoked once per active lane. Prefetch the first argument
+			# (normally the object the callback operates on) of all lanes before touching any of them.
+			Body = '\t\\\n\t\t{\t\\\n'
+			Body += '\t\t\tFCppCallbackCounters::RecordGangCall(LaneMask);\t\\\n'
+			Body += '\t\t\tauto _PerLane = [&]({0}){1} CppCode;\t\\\n'.format(ArgDecl, ' -> ReturnType' if bUseReturnType else '')
+			if Count > 0:
+				Body += '\t\t\tfor (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)\t\\\n'
+				Body += '\t\t\t{\t\\\n'
+				Body += '\t\t\t\tCppGangPrefetch(_Lanes0[FMath::CountTrailingZeros(_Mask)]);\t\\\n'
+				Body += '\t\t\t}\t\\\n'
+			Body += '\t\t\tfor (uint32 _Mask = (uint32)LaneMask; _Mask != 0; _Mask &= _Mask - 1)\t\\\n'
+			Body += '\t\t\t{\t\\\n'
+			Body += '\t\t\t\tconst int32 _Lane = (int32)FMath::CountTrailingZeros(_Mask);\t\\\n'
+			Body += '\t\t\t\t{0}_PerLane({1});\t\\\n'.format('_ReturnValues[_Lane] = ' if bUseReturnType else '', LaneFwd)
+			Body += '\t\t\t}\t\\\n'
+			Body += '\t\t}'
+		File.write(r'''	#define DefineCppGangCallback_{0}Arg{1}({2}FuncName, {3}CppCode)	\
+		{4} void FuncName ## _CppGangCallback({5}){6}
+'''.format(
+			Count,
+			'_RetVal' if bUseReturnType else '',
+			'ReturnType, ' if bUseReturnType else '',
+			MacroArgs,
+			'friend' if bFriend else 'extern "C"',
+			GangArgDecl,
+			Body))
+
+def EmitAllUndefsCppSide():
+	EmitCallbackMacrosUndefsCppSide(False)
+	EmitCallbackMacrosUndefsCppSide(True)
+	EmitCallbackMacrosUndefsCppSide(False, True)
+	EmitCallbackMacrosUndefsCppSide(True, True)
 
 File.write(r'''// Autogenerated by GenerateCallbackMacros.py, do not modify.
 
@@ -96,6 +189,7 @@ File.write(r'''// Autogenerated by GenerateCallbackMacros.py, do not modify.
 			{	\
 				ReturnValue = insert(ReturnValue, Index, FuncName ## _CppCallback ArgFwd);	\
 			}	\
+			return ReturnValue;	\
 		}
 
 ''')
@@ -103,32 +197,51 @@ File.write(r'''// Autogenerated by GenerateCallbackMacros.py, do not modify.
 EmitCallbackMacrosISPCSide(False)
 EmitCallbackMacrosISPCSide(True)
 
+File.write(r'''
+	// Gang flavour: one call per gang instead of one per active lane. Arguments and return values are passed
+	// as uniform arrays indexed by lane, along with the mask of active lanes. Argument types must not be
+	// top-level const.
+''')
+
+EmitGangCallbackMacrosISPCSide(False)
+EmitGangCallbackMacrosISPCSide(True)
+
 File.write(r'''#elif defined(EMIT_FORWARD_DECLARATIONS)
 ''')
 
-EmitCallbackMacrosUndefsCppSide(False)
-EmitCallbackMacrosUndefsCppSide(True)
+EmitAllUndefsCppSide()
 
 EmitCallbackMacrosCppSide(False, False, True)
 EmitCallbackMacrosCppSide(True, False, True)
+EmitGangCallbackMacrosCppSide(False, False, True)
+EmitGangCallbackMacrosCppSide(True, False, True)
 
 File.write(r'''#elif defined(EMIT_FRIEND_DECLARATIONS)
 ''')
 
-EmitCallbackMacrosUndefsCppSide(False)
-EmitCallbackMacrosUndefsCppSide(True)
+EmitAllUndefsCppSide()
 
 EmitCallbackMacrosCppSide(False, True, True)
 EmitCallbackMacrosCppSide(True, True, True)
+EmitGangCallbackMacrosCppSide(False, True, True)
+EmitGangCallbackMacrosCppSide(True, True, True)
 
 File.write(r'''#else
+	#ifndef CPP_GANG_CALLBACK_HELPERS
+	#define CPP_GANG_CALLBACK_HELPERS
+		template<typename T>
+		inline typename TEnableIf<TIsPointer<T>::Value>::Type CppGangPrefetch(T Ptr) { FPlatformMisc::Prefetch(Ptr); }
+		template<typename T>
+		inline typename TEnableIf<!TIsPointer<T>::Value>::Type CppGangPrefetch(const T&) {}
+	#endif
 ''')
 
-EmitCallbackMacrosUndefsCppSide(False)
-EmitCallbackMacrosUndefsCppSide(True)
+EmitAllUndefsCppSide()
 
 EmitCallbackMacrosCppSide(False, False, False)
 EmitCallbackMacrosCppSide(True, False, False)
+EmitGangCallbackMacrosCppSide(False, False, False)
+EmitGangCallbackMacrosCppSide(True, False, False)
 
 File.write(r'''#endif
-''')
\ No newline at end of file
+''')
\ No newline at end of file
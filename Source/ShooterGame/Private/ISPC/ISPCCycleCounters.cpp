@@ -0,0 +1,75 @@
+#include "ShooterGame.h"
+#include "ISPCCycleCounters.h"
+#include "ShooterISPCMovementSystem.ispc.h"
+
+namespace
+{
+	/** Per-thread timestamp counter deltas, so that kernels running on task graph workers don't contend on every timer. */
+	struct FThreadBuffer
+	{
+		uint64 Timestamps[ISPCCycleStat_Count] = {};
+	};
+
+	// Buffers live until shutdown; they're only ever read while no kernel is running.
+	FCriticalSection BuffersLock;
+	TArray<FThreadBuffer*> Buffers;
+	thread_local FThreadBuffer* ThreadBuffer = nullptr;
+
+	FThreadBuffer& GetThreadBuffer()
+	{
+		if (ThreadBuffer == nullptr)
+		{
+			ThreadBuffer = new FThreadBuffer();
+			FScopeLock Lock(&BuffersLock);
+			Buffers.Add(ThreadBuffer);
+		}
+		return *ThreadBuffer;
+	}
+
+	/** Calibration point of the previous flush, seeded at startup so that the first flush has a ratio to go by. */
+	struct FCalibration
+	{
+		uint64 Timestamp = ispc::ReadTimestamp();
+		uint64 Cycles = FPlatformTime::Cycles64();
+	};
+	FCalibration Last;
+}
+
+extern "C" void ISPCCycleCounters_Add(int32 Stat, int64 Timestamps)
+{
+#if STATS
+	GetThreadBuffer().Timestamps[Stat] += Timestamps;
+#endif
+}
+
+void ISPCCycleCounters::Flush(uint64 (&OutCycles)[ISPCCycleStat_Count])
+{
+	uint64 Timestamps[ISPCCycleStat_Count] = {};
+	{
+		FScopeLock Lock(&BuffersLock);
+		for (FThreadBuffer* Buffer : Buffers)
+		{
+			for (int32 Stat = 0; Stat < ISPCCycleStat_Count; ++Stat)
+			{
+				Timestamps[Stat] += Buffer->Timestamps[Stat];
+				Buffer->Timestamps[Stat] = 0;
+			}
+		}
+	}
+
+	// The kernel's clock() reads the CPU timestamp counter, which doesn't necessarily tick at the rate of
+	// FPlatformTime::Cycles() (e.g. QueryPerformanceCounter() on Windows). Rescale using the ratio of the two over
+	// the time since the previous flush, or since startup for the first one.
+	const uint64 Timestamp = ispc::ReadTimestamp();
+	const uint64 Cycles = FPlatformTime::Cycles64();
+	const double Scale = Timestamp > Last.Timestamp
+		? (double)(Cycles - Last.Cycles) / (double)(Timestamp - Last.Timestamp)
+		: 0.0;
+	Last.Timestamp = Timestamp;
+	Last.Cycles = Cycles;
+
+	for (int32 Stat = 0; Stat < ISPCCycleStat_Count; ++Stat)
+	{
+		OutCycles[Stat] = (uint64)(Timestamps[Stat] * Scale);
+	}
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "ISPCCycleStats.h"
+
+namespace ISPCCycleCounters
+{
+	/**
+	 * Sums the cycles the kernels accumulated on all threads since the last call, in FPlatformTime::Cycles() units,
+	 * and clears them. Game thread only, outside of kernels.
+	 */
+	void Flush(uint64 (&OutCycles)[ISPCCycleStat_Count]);
+}
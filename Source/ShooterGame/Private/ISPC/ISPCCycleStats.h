@@ -0,0 +1,17 @@
+#pragma once
+
+// Cycle counters timed inside the kernel (see CYCLE_COUNTER_BEGIN() in ShooterISPCMovementSystem_Boilerplate.inl).
+// Each one is flushed into the STAT_Char* stat of the same name after the tick, so that "stat UnrCppChar" compares
+// both implementations side by side. Shared between C++ and ISPC. Only list regions the kernel actually times; the
+// rest of its stats are SCOPE_CYCLE_COUNTER() no-ops in code that is still UNIMPLEMENTED_CODE.
+#define ISPC_CYCLE_STATS(Op)	\
+	Op(STAT_CharacterMovementPerformMovement)	\
+	Op(STAT_CharMoveUpdateDelegate)
+
+#define ISPC_CYCLE_STAT_ENUM_ENTRY(Stat)	ISPCCycleStat_##Stat,
+enum EISPCCycleStat
+{
+	ISPC_CYCLE_STATS(ISPC_CYCLE_STAT_ENUM_ENTRY)
+	ISPCCycleStat_Count
+};
+#undef ISPC_CYCLE_STAT_ENUM_ENTRY
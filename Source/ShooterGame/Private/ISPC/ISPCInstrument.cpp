@@ -0,0 +1,243 @@
+#include "ShooterGame.h"
+#include "ISPCInstrument.h"
+#include "ShooterISPCMovementSystem.ispc.h"
+#include "Misc/FileHelper.h"
+
+#if ISPC_INSTRUMENTATION
+
+DEFINE_LOG_CATEGORY_STATIC(LogISPCInstrument, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("ISPCInstrument"), STATGROUP_ISPCInstrument, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ISPC Instrumented Points"), STAT_ISPCInstrumentPoints, STATGROUP_ISPCInstrument);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ISPC Active Lanes"), STAT_ISPCInstrumentActiveLanes, STATGROUP_ISPCInstrument);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("ISPC Lane Utilisation %"), STAT_ISPCInstrumentLaneUtilisation, STATGROUP_ISPCInstrument);
+
+namespace
+{
+	/** An instrumentation point. ISPC passes string literals, so the pointers identify it just as well as the contents. */
+	struct FCallSite
+	{
+		const char* File;
+		const char* Note;
+		int32 Line;
+
+		bool operator==(const FCallSite& Other) const
+		{
+			return File == Other.File && Note == Other.Note && Line == Other.Line;
+		}
+
+		friend uint32 GetTypeHash(const FCallSite& Site)
+		{
+			return HashCombine(HashCombine(PointerHash(Site.File), PointerHash(Site.Note)), ::GetTypeHash(Site.Line));
+		}
+	};
+
+	struct FCallSiteCounts
+	{
+		uint64 Calls = 0;
+		uint64 ActiveLanes = 0;
+	};
+
+	/** Per-thread tallies, so that kernels running on task graph workers don't contend on every branch. */
+	struct FThreadBuffer
+	{
+		TMap<FCallSite, FCallSiteCounts> Sites;
+		uint64 FrameCalls = 0;
+		uint64 FrameActiveLanes = 0;
+	};
+
+	// Buffers live until shutdown; they're only ever read while no kernel is running.
+	FCriticalSection BuffersLock;
+	TArray<FThreadBuffer*> Buffers;
+	thread_local FThreadBuffer* ThreadBuffer = nullptr;
+
+	FThreadBuffer& GetThreadBuffer()
+	{
+		if (ThreadBuffer == nullptr)
+		{
+			ThreadBuffer = new FThreadBuffer();
+			FScopeLock Lock(&BuffersLock);
+			Buffers.Add(ThreadBuffer);
+		}
+		return *ThreadBuffer;
+	}
+
+	float GetUtilisation(const FCallSiteCounts& Counts)
+	{
+		return Counts.Calls > 0 ? 100.f * Counts.ActiveLanes / ((double)Counts.Calls * ispc::GetProgramCount()) : 0.f;
+	}
+
+	/** Names a function after its entry line in the source, e.g. "void PhysWalking(FISPCMovementContext Ctx, ...)" gives "PhysWalking". */
+	FString GetFunctionName(const TArray<FString>& SourceLines, const char* File, int32 EntryLine)
+	{
+		if (SourceLines.IsValidIndex(EntryLine - 1))
+		{
+			const FString& Text = SourceLines[EntryLine - 1];
+			int32 Paren;
+			if (Text.FindChar(TEXT('('), Paren))
+			{
+				int32 Begin = Paren;
+				while (Begin > 0 && (FChar::IsAlnum(Text[Begin - 1]) || Text[Begin - 1] == TEXT('_')))
+				{
+					--Begin;
+				}
+				if (Begin < Paren)
+				{
+					return Text.Mid(Begin, Paren - Begin);
+				}
+			}
+		}
+		return FString::Printf(TEXT("%s:%d"), *FPaths::GetCleanFilename(ANSI_TO_TCHAR(File)), EntryLine);
+	}
+
+	/**
+	 * Dumps functions and call sites sorted by lane utilisation, worst first. Call sites are attributed to the
+	 * closest function entry above them.
+	 */
+	void DumpReport(const TArray<FString>& Args)
+	{
+		const FString Filter = Args.Num() > 0 ? Args[0] : FString();
+		const int32 MaxSites = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 50;
+
+		TMap<FCallSite, FCallSiteCounts> Sites;
+		{
+			FScopeLock Lock(&BuffersLock);
+			for (const FThreadBuffer* Buffer : Buffers)
+			{
+				for (const auto& Pair : Buffer->Sites)
+				{
+					FCallSiteCounts& Counts = Sites.FindOrAdd(Pair.Key);
+					Counts.Calls += Pair.Value.Calls;
+					Counts.ActiveLanes += Pair.Value.ActiveLanes;
+				}
+			}
+		}
+
+		// Function entries per source file, sorted by line.
+		TMap<const char*, TArray<int32>> EntryLines;
+		for (const auto& Pair : Sites)
+		{
+			if (FCStringAnsi::Strstr(Pair.Key.Note, "function entry"))
+			{
+				EntryLines.FindOrAdd(Pair.Key.File).Add(Pair.Key.Line);
+			}
+		}
+		TMap<const char*, TArray<FString>> SourceLines;
+		for (auto& Pair : EntryLines)
+		{
+			Pair.Value.Sort();
+			FFileHelper::LoadFileToStringArray(SourceLines.Add(Pair.Key), ANSI_TO_TCHAR(Pair.Key));
+		}
+
+		struct FReportEntry
+		{
+			FString Function;
+			FCallSite Site;
+			FCallSiteCounts Counts;
+		};
+		TArray<FReportEntry> SiteEntries;
+		TMap<FString, FCallSiteCounts> Functions;
+		for (const auto& Pair : Sites)
+		{
+			FString Function = TEXT("<unknown>");
+			if (const TArray<int32>* Lines = EntryLines.Find(Pair.Key.File))
+			{
+				int32 EntryLine = INDEX_NONE;
+				for (int32 Line : *Lines)
+				{
+					if (Line > Pair.Key.Line)
+					{
+						break;
+					}
+					EntryLine = Line;
+				}
+				if (EntryLine != INDEX_NONE)
+				{
+					Function = GetFunctionName(SourceLines.FindChecked(Pair.Key.File), Pair.Key.File, EntryLine);
+				}
+			}
+			if (!Filter.IsEmpty() && !Function.Contains(Filter))
+			{
+				continue;
+			}
+			FCallSiteCounts& FunctionCounts = Functions.FindOrAdd(Function);
+			FunctionCounts.Calls += Pair.Value.Calls;
+			FunctionCounts.ActiveLanes += Pair.Value.ActiveLanes;
+			SiteEntries.Add({ Function, Pair.Key, Pair.Value });
+		}
+
+		UE_LOG(LogISPCInstrument, Display, TEXT("Functions by lane utilisation (gang width %d):"), ispc::GetProgramCount());
+		Functions.ValueSort([](const FCallSiteCounts& A, const FCallSiteCounts& B) { return GetUtilisation(A) < GetUtilisation(B); });
+		for (const auto& Pair : Functions)
+		{
+			UE_LOG(LogISPCInstrument, Display, TEXT("  %5.1f%%  %12llu points  %s"), GetUtilisation(Pair.Value), Pair.Value.Calls, *Pair.Key);
+		}
+
+		UE_LOG(LogISPCInstrument, Display, TEXT("Worst call sites:"));
+		SiteEntries.Sort([](const FReportEntry& A, const FReportEntry& B) { return GetUtilisation(A.Counts) < GetUtilisation(B.Counts); });
+		for (int32 Index = 0; Index < FMath::Min(MaxSites, SiteEntries.Num()); ++Index)
+		{
+			const FReportEntry& Entry = SiteEntries[Index];
+			UE_LOG(LogISPCInstrument, Display, TEXT("  %5.1f%%  %12llu points  %s:%d  %s (%s)"),
+				GetUtilisation(Entry.Counts), Entry.Counts.Calls,
+				*FPaths::GetCleanFilename(ANSI_TO_TCHAR(Entry.Site.File)), Entry.Site.Line, ANSI_TO_TCHAR(Entry.Site.Note), *Entry.Function);
+		}
+	}
+
+	void Reset(const TArray<FString>& Args)
+	{
+		FScopeLock Lock(&BuffersLock);
+		for (FThreadBuffer* Buffer : Buffers)
+		{
+			Buffer->Sites.Reset();
+		}
+	}
+
+	FAutoConsoleCommand DumpReportCommand(
+		TEXT("ispc.InstrumentReport"),
+		TEXT("Dumps the ISPC kernel's functions and call sites sorted by lane utilisation, worst first.\n")
+		TEXT("Arguments: [function name filter, e.g. PhysWalking] [number of call sites to list, default 50]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&DumpReport));
+
+	FAutoConsoleCommand ResetCommand(
+		TEXT("ispc.InstrumentReset"),
+		TEXT("Clears the ISPC instrumentation data gathered so far."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Reset));
+}
+
+// Called by kernels built with --instrument at every instrumentation point (function entries, branches, loops).
+extern "C" void ISPCInstrument(const char* File, const char* Note, int Line, uint64 Mask)
+{
+	int32 ActiveLanes = 0;
+	for (; Mask != 0; Mask &= Mask - 1)
+	{
+		++ActiveLanes;
+	}
+
+	FThreadBuffer& Buffer = GetThreadBuffer();
+	FCallSiteCounts& Counts = Buffer.Sites.FindOrAdd(FCallSite{ File, Note, Line });
+	++Counts.Calls;
+	Counts.ActiveLanes += ActiveLanes;
+	++Buffer.FrameCalls;
+	Buffer.FrameActiveLanes += ActiveLanes;
+}
+
+void ISPCInstrumentation::PublishFrameStats()
+{
+	FCallSiteCounts Frame;
+	{
+		FScopeLock Lock(&BuffersLock);
+		for (FThreadBuffer* Buffer : Buffers)
+		{
+			Frame.Calls += Buffer->FrameCalls;
+			Frame.ActiveLanes += Buffer->FrameActiveLanes;
+			Buffer->FrameCalls = Buffer->FrameActiveLanes = 0;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ISPCInstrumentPoints, Frame.Calls);
+	SET_DWORD_STAT(STAT_ISPCInstrumentActiveLanes, Frame.ActiveLanes);
+	SET_FLOAT_STAT(STAT_ISPCInstrumentLaneUtilisation, GetUtilisation(Frame));
+}
+
+#endif	// ISPC_INSTRUMENTATION
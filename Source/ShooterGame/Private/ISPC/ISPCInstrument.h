@@ -0,0 +1,11 @@
+#pragma once
+
+// ISPC: Collects the data emitted by kernels built with --instrument (see bUseInstrumentation in
+// ShooterGame.Build.cs). Compiled out otherwise.
+#if ISPC_INSTRUMENTATION
+namespace ISPCInstrumentation
+{
+	/** Publishes the lane utilisation totals gathered since the last call to the ISPCInstrument stat group. Game thread only, outside of kernels. */
+	void PublishFrameStats();
+}
+#endif
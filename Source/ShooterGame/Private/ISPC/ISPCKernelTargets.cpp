@@ -0,0 +1,94 @@
+#include "ShooterGame.h"
+#include "ISPCKernelTargets.h"
+
+// ISAs as numbered by GetTargetISA() in ShooterISPCMovementSystem.ispc.
+#define ISPC_KERNEL_TARGET_ENTRY_POINTS(Suffix, ISA)	\
+	{	\
+		ISA,	\
+		&ispc::GetProgramCount##Suffix,	\
+		&ispc::Tick##Suffix,	\
+		&ispc::TickParallel##Suffix,	\
+		&ispc::PrePhysics##Suffix,	\
+		&ispc::TickWalking##Suffix,	\
+		&ispc::TickFalling##Suffix,	\
+		&ispc::TickNavWalking##Suffix,	\
+		&ispc::TickOtherMode##Suffix,	\
+		&ispc::TickRequeued##Suffix,	\
+		&ispc::PostPhysics##Suffix,	\
+	}
+
+// The per-target symbols aren't in the generated header, which only declares the dispatch functions.
+#define ISPC_DECLARE_KERNEL_TARGET(Suffix)	\
+	namespace ispc	\
+	{	\
+		extern "C"	\
+		{	\
+			int32_t GetProgramCount##Suffix();	\
+			void Tick##Suffix(float DeltaSeconds, FISPCMovementArrays* Arrays, int32_t Count);	\
+			void TickParallel##Suffix(float DeltaSeconds, FISPCMovementArrays* Arrays, int32_t Count, int32_t ChunkSize);	\
+			void PrePhysics##Suffix(float DeltaSeconds, FISPCMovementArrays* Arrays, FISPCPhysicsQueue* Queue, int32_t Count, int32_t ChunkSize);	\
+			void TickWalking##Suffix(FISPCMovementArrays* Arrays, FISPCPhysicsQueue* Queue, const int32_t* Indices, int32_t Count, int32_t ChunkSize);	\
+			void TickFalling##Suffix(FISPCMovementArrays* Arrays, FISPCPhysicsQueue* Queue, const int32_t* Indices, int32_t Count, int32_t ChunkSize);	\
+			void TickNavWalking##Suffix(FISPCMovementArrays* Arrays, FISPCPhysicsQueue* Queue, const int32_t* Indices, int32_t Count, int32_t ChunkSize);	\
+			void TickOtherMode##Suffix(FISPCMovementArrays* Arrays, FISPCPhysicsQueue* Queue, const int32_t* Indices, int32_t Count, int32_t ChunkSize, EMovementMode Mode);	\
+			void TickRequeued##Suffix(FISPCMovementArrays* Arrays, FISPCPhysicsQueue* Queue, const int32_t* Indices, int32_t Count, int32_t ChunkSize);	\
+			void PostPhysics##Suffix(float DeltaSeconds, FISPCMovementArrays* Arrays, FISPCPhysicsQueue* Queue, int32_t Count, int32_t ChunkSize);	\
+		}	\
+	}
+
+#if ISPC_HAS_TARGET_SSE4
+ISPC_DECLARE_KERNEL_TARGET(_sse4)
+#endif
+#if ISPC_HAS_TARGET_AVX2
+ISPC_DECLARE_KERNEL_TARGET(_avx2)
+#endif
+#if ISPC_HAS_TARGET_AVX512SKX
+ISPC_DECLARE_KERNEL_TARGET(_avx512skx)
+#endif
+
+namespace
+{
+	const FISPCKernelTarget Dispatched = ISPC_KERNEL_TARGET_ENTRY_POINTS(, ispc::GetTargetISA());
+
+	const FISPCKernelTarget Compiled[] =
+	{
+#if ISPC_HAS_TARGET_SSE4
+		ISPC_KERNEL_TARGET_ENTRY_POINTS(_sse4, 2),
+#endif
+#if ISPC_HAS_TARGET_AVX2
+		ISPC_KERNEL_TARGET_ENTRY_POINTS(_avx2, 4),
+#endif
+#if ISPC_HAS_TARGET_AVX512SKX
+		ISPC_KERNEL_TARGET_ENTRY_POINTS(_avx512skx, 5),
+#endif
+		// Keeps the array non-empty for single-target builds; not part of GetCompiled().
+		ISPC_KERNEL_TARGET_ENTRY_POINTS(, INDEX_NONE)
+	};
+
+	const FISPCKernelTarget* Forced = nullptr;
+}
+
+namespace ISPCKernelTargets
+{
+	const FISPCKernelTarget& Get()
+	{
+		return Forced ? *Forced : Dispatched;
+	}
+
+	void Force(const FISPCKernelTarget* Target)
+	{
+		check(IsInGameThread());
+		check(Target == nullptr || IsSupported(*Target));
+		Forced = Target;
+	}
+
+	TArrayView<const FISPCKernelTarget> GetCompiled()
+	{
+		return TArrayView<const FISPCKernelTarget>(Compiled, ARRAY_COUNT(Compiled) - 1);
+	}
+
+	bool IsSupported(const FISPCKernelTarget& Target)
+	{
+		return Target.ISA <= Dispatched.ISA;
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "ShooterISPCMovementSystem.ispc.h"
+
+// ISPC: Built for several targets, ISPC links an object per target next to the dispatch object, each exporting the
+// kernel's functions suffixed with its ISA. ShooterGame.Build.cs defines ISPC_HAS_TARGET_<ISA> for each of them.
+#ifndef ISPC_HAS_TARGET_SSE4
+	#define ISPC_HAS_TARGET_SSE4 0
+#endif
+#ifndef ISPC_HAS_TARGET_AVX2
+	#define ISPC_HAS_TARGET_AVX2 0
+#endif
+#ifndef ISPC_HAS_TARGET_AVX512SKX
+	#define ISPC_HAS_TARGET_AVX512SKX 0
+#endif
+
+/** Movement kernel entry points the system calls, for one ISPC target or for the auto-dispatch. */
+struct FISPCKernelTarget
+{
+	/** GetTargetISA() of the target, known without running its code. */
+	int32 ISA;
+	int32_t (*GetProgramCount)();
+	void (*Tick)(float DeltaSeconds, ispc::FISPCMovementArrays* Arrays, int32_t Count);
+	void (*TickParallel)(float DeltaSeconds, ispc::FISPCMovementArrays* Arrays, int32_t Count, int32_t ChunkSize);
+	void (*PrePhysics)(float DeltaSeconds, ispc::FISPCMovementArrays* Arrays, ispc::FISPCPhysicsQueue* Queue, int32_t Count, int32_t ChunkSize);
+	void (*TickWalking)(ispc::FISPCMovementArrays* Arrays, ispc::FISPCPhysicsQueue* Queue, const int32_t* Indices, int32_t Count, int32_t ChunkSize);
+	void (*TickFalling)(ispc::FISPCMovementArrays* Arrays, ispc::FISPCPhysicsQueue* Queue, const int32_t* Indices, int32_t Count, int32_t ChunkSize);
+	void (*TickNavWalking)(ispc::FISPCMovementArrays* Arrays, ispc::FISPCPhysicsQueue* Queue, const int32_t* Indices, int32_t Count, int32_t ChunkSize);
+	void (*TickOtherMode)(ispc::FISPCMovementArrays* Arrays, ispc::FISPCPhysicsQueue* Queue, const int32_t* Indices, int32_t Count, int32_t ChunkSize, ispc::EMovementMode Mode);
+	void (*TickRequeued)(ispc::FISPCMovementArrays* Arrays, ispc::FISPCPhysicsQueue* Queue, const int32_t* Indices, int32_t Count, int32_t ChunkSize);
+	void (*PostPhysics)(float DeltaSeconds, ispc::FISPCMovementArrays* Arrays, ispc::FISPCPhysicsQueue* Queue, int32_t Count, int32_t ChunkSize);
+};
+
+namespace ISPCKernelTargets
+{
+	/** Entry points the system ticks with: the forced target if there is one, the auto-dispatch otherwise. */
+	const FISPCKernelTarget& Get();
+
+	/** Forces the system onto Target, which must be supported, or back to the auto-dispatch with nullptr. Game thread only. */
+	void Force(const FISPCKernelTarget* Target);
+
+	/** Per-target entry points of a multi-target build, narrowest first. Empty for a single-target build. */
+	TArrayView<const FISPCKernelTarget> GetCompiled();
+
+	/** Whether this machine can run Target. The auto-dispatch picks the widest supported target, and ISAs are numbered by width. */
+	bool IsSupported(const FISPCKernelTarget& Target);
+}
@@ -0,0 +1,347 @@
+#pragma once
+
+#include "CppInterop.h"
+#include "ISPCWalkableSlopeTable.h"
+
+/**
+ * Persistent structure-of-arrays backing store for FISPCMovementArrays.
+ * Index N in every array corresponds to UShooterUnrolledCppMovementSystem::Components[N].
+ * Storage is only (re)allocated on registration changes; most values are refreshed every frame.
+ */
+struct FISPCMovementStore
+{
+	TArray<void*> Comp;
+	TArray<void*> UpdatedComponent;
+	TArray<void*> DeferredUpdatedMoveComponent;
+	TArray<void*> UpdatedPrimitive;
+	TArray<void*> CharacterOwner;
+	TArray<void*> CharacterOwner_MovementBase;
+	TArray<void*> UpdatedComponent_Owner;
+	TArray<const void*> CollisionQueryParams;
+	TArray<const void*> CollisionResponseParams;
+
+	TArray<EComponentMobility::Type> UpdatedComponent_Mobility;
+	TArray<ENetRole> CharacterOwner_Role;
+	TArray<bool> UpdatedComponent_IsSimulatingPhysics;
+	TArray<bool> CharacterOwner_bClientUpdating;
+	TArray<bool> CharacterOwner_IsPlayingRootMotion;
+	TArray<bool> CharacterOwner_bServerMoveIgnoreRootMotion;
+	TArray<bool> CharacterOwner_IsMatineeControlled;
+	TArray<bool> CharacterOwner_HasAuthority;
+	TArray<void*> CharacterOwner_GetMesh;
+	TArray<bool> NavAgentProps_bCanCrouch;
+	TArray<FVector2D> DefaultCharacter_CapsuleComponent_UnscaledSize;
+	TArray<ECollisionChannel> UpdatedComponent_CollisionObjectType;
+	TArray<FCollisionShape> PawnCapsuleCollisionShape_ShrinkCapsuleExtent_None;
+	TArray<bool> CurrentRootMotion_HasActiveRootMotionSources;
+	TArray<bool> RootMotionParams_bHasRootMotion;
+
+	TArray<ENetMode> NetMode;
+	TArray<bool> bCrouchMaintainsBaseLocation;
+	TArray<bool> bWantsToCrouch;
+	TArray<bool> bWantsToLeaveNavWalking;
+	TArray<bool> bAllowPhysicsRotationDuringAnimRootMotion;
+	TArray<float> CrouchedHalfHeight;
+	TArray<float> GravityScale;
+	TArray<float> BrakingFrictionFactor;
+	TArray<int32> MaxSimulationIterations;
+	TArray<EMoveComponentFlags> MoveComponentFlags;
+
+	TArray<FVector> UpdatedComponent_ComponentScale;
+	TArray<float> WalkableFloorZ;
+	TArray<bool> bScalarFallback;
+
+	// Physics volume snapshot, see FISPCMovementArrays.
+	TArray<float> PhysicsVolume_GravityZ;
+	TArray<bool> PhysicsVolume_bWaterVolume;
+	TArray<float> PhysicsVolume_FluidFriction;
+	TArray<float> PhysicsVolume_TerminalVelocity;
+
+	// CurrentFloor, hot fields and cold record. See FISPCMovementArrays.
+	TArray<bool> CurrentFloor_bBlockingHit;
+	TArray<bool> CurrentFloor_bWalkableFloor;
+	TArray<bool> CurrentFloor_bLineTrace;
+	TArray<float> CurrentFloor_FloorDist;
+	TArray<float> CurrentFloor_LineDist;
+	TArray<float> CurrentFloor_Time;
+	TArray<FVector> CurrentFloor_ImpactPoint;
+	TArray<FVector> CurrentFloor_ImpactNormal;
+	TArray<FFindFloorResult> CurrentFloor_Cold;
+	TArray<bool> CurrentFloor_bColdDirty;
+
+	TArray<EMovementMode> MovementMode;
+	TArray<bool> CharacterOwner_bIsCrouched;
+	TArray<FVector> CharacterOwner_CapsuleComponent_Size;
+	TArray<FQuat> UpdatedComponent_ComponentQuat;
+	TArray<FVector> UpdatedComponent_ComponentLocation;
+
+	TArray<FVector> PendingImpulseToApply;
+	TArray<FVector> PendingForceToApply;
+	TArray<FVector> PendingLaunchVelocity;
+
+	TArray<bool> bForceNextFloorCheck;
+	TArray<bool> bShrinkProxyCapsule;
+	TArray<bool> bDeferUpdateBasedMovement;
+	TArray<bool> bDeferUpdateMoveComponent;
+	TArray<bool> bHasRequestedVelocity;
+	TArray<bool> bMovementInProgress;
+	TArray<bool> bJustTeleported;
+
+	TArray<FVector> LastUpdateLocation;
+	TArray<FQuat> LastUpdateRotation;
+	TArray<FVector> LastUpdateVelocity;
+	TArray<FVector> Velocity;
+
+	TArray<float> ServerLastTransformUpdateTimeStamp;
+
+	/** Calls Func on every field array. Keeps the per-field bookkeeping in one place. */
+	template<typename FuncType>
+	void ForEachArray(FuncType&& Func)
+	{
+		Func(Comp); Func(UpdatedComponent); Func(DeferredUpdatedMoveComponent); Func(UpdatedPrimitive);
+		Func(CharacterOwner); Func(CharacterOwner_MovementBase); Func(UpdatedComponent_Owner);
+		Func(CollisionQueryParams); Func(CollisionResponseParams);
+
+		Func(UpdatedComponent_Mobility); Func(CharacterOwner_Role); Func(UpdatedComponent_IsSimulatingPhysics);
+		Func(CharacterOwner_bClientUpdating); Func(CharacterOwner_IsPlayingRootMotion); Func(CharacterOwner_bServerMoveIgnoreRootMotion);
+		Func(CharacterOwner_IsMatineeControlled); Func(CharacterOwner_HasAuthority); Func(CharacterOwner_GetMesh);
+		Func(NavAgentProps_bCanCrouch); Func(DefaultCharacter_CapsuleComponent_UnscaledSize); Func(UpdatedComponent_CollisionObjectType);
+		Func(PawnCapsuleCollisionShape_ShrinkCapsuleExtent_None); Func(CurrentRootMotion_HasActiveRootMotionSources); Func(RootMotionParams_bHasRootMotion);
+
+		Func(NetMode); Func(bCrouchMaintainsBaseLocation); Func(bWantsToCrouch); Func(bWantsToLeaveNavWalking);
+		Func(bAllowPhysicsRotationDuringAnimRootMotion); Func(CrouchedHalfHeight); Func(GravityScale);
+		Func(BrakingFrictionFactor); Func(MaxSimulationIterations); Func(MoveComponentFlags);
+
+		Func(UpdatedComponent_ComponentScale); Func(PhysicsVolume_GravityZ); Func(PhysicsVolume_bWaterVolume);
+		Func(PhysicsVolume_FluidFriction); Func(PhysicsVolume_TerminalVelocity); Func(WalkableFloorZ); Func(bScalarFallback);
+
+		Func(CurrentFloor_bBlockingHit); Func(CurrentFloor_bWalkableFloor); Func(CurrentFloor_bLineTrace);
+		Func(CurrentFloor_FloorDist); Func(CurrentFloor_LineDist); Func(CurrentFloor_Time);
+		Func(CurrentFloor_ImpactPoint); Func(CurrentFloor_ImpactNormal); Func(CurrentFloor_Cold); Func(CurrentFloor_bColdDirty);
+
+		Func(MovementMode); Func(CharacterOwner_bIsCrouched); Func(CharacterOwner_CapsuleComponent_Size); Func(UpdatedComponent_ComponentQuat);
+		Func(UpdatedComponent_ComponentLocation);
+
+		Func(PendingImpulseToApply); Func(PendingForceToApply); Func(PendingLaunchVelocity);
+
+		Func(bForceNextFloorCheck); Func(bShrinkProxyCapsule); Func(bDeferUpdateBasedMovement); Func(bDeferUpdateMoveComponent);
+		Func(bHasRequestedVelocity); Func(bMovementInProgress); Func(bJustTeleported);
+
+		Func(LastUpdateLocation); Func(LastUpdateRotation); Func(LastUpdateVelocity); Func(Velocity);
+
+		Func(ServerLastTransformUpdateTimeStamp);
+	}
+
+	int32 Num() const
+	{
+		return Comp.Num();
+	}
+
+	/** Appends zeroed slots; the values are filled in by the next gather. */
+	void AddSlots(int32 Count)
+	{
+		ForEachArray([Count](auto& Array) { Array.AddZeroed(Count); });
+	}
+
+	/** Moves the last slot into Index, mirroring Components.RemoveAtSwap(). */
+	void RemoveSlotSwap(int32 Index)
+	{
+		ForEachArray([Index](auto& Array) { Array.RemoveAtSwap(Index, 1, false); });
+	}
+
+	void Reset()
+	{
+		ForEachArray([](auto& Array) { Array.Empty(); });
+	}
+
+	/** Splits Floor into the hot fields and the cold record of slot Index. */
+	void SetCurrentFloor(int32 Index, const FFindFloorResult& Floor)
+	{
+		CurrentFloor_Cold[Index] = Floor;
+		CurrentFloor_bColdDirty[Index] = false;
+		SetCurrentFloorHotFields(Index, Floor);
+	}
+
+	/** Writes the hot fields of slot Index over Floor. */
+	void GetCurrentFloorHotFields(int32 Index, FFindFloorResult& Floor) const
+	{
+		Floor.bBlockingHit = CurrentFloor_bBlockingHit[Index];
+		Floor.bWalkableFloor = CurrentFloor_bWalkableFloor[Index];
+		Floor.bLineTrace = CurrentFloor_bLineTrace[Index];
+		Floor.FloorDist = CurrentFloor_FloorDist[Index];
+		Floor.LineDist = CurrentFloor_LineDist[Index];
+		Floor.HitResult.Time = CurrentFloor_Time[Index];
+		Floor.HitResult.ImpactPoint = CurrentFloor_ImpactPoint[Index];
+		Floor.HitResult.ImpactNormal = CurrentFloor_ImpactNormal[Index];
+	}
+
+	/** Whether the hot fields of slot Index differ from Floor. */
+	bool CurrentFloorHotFieldsDiffer(int32 Index, const FFindFloorResult& Floor) const
+	{
+		return Floor.bBlockingHit != CurrentFloor_bBlockingHit[Index]
+			|| Floor.bWalkableFloor != CurrentFloor_bWalkableFloor[Index]
+			|| Floor.bLineTrace != CurrentFloor_bLineTrace[Index]
+			|| Floor.FloorDist != CurrentFloor_FloorDist[Index]
+			|| Floor.LineDist != CurrentFloor_LineDist[Index]
+			|| Floor.HitResult.Time != CurrentFloor_Time[Index]
+			|| Floor.HitResult.ImpactPoint != CurrentFloor_ImpactPoint[Index]
+			|| Floor.HitResult.ImpactNormal != CurrentFloor_ImpactNormal[Index];
+	}
+
+	/** Materialises the full floor result of slot Index. */
+	FFindFloorResult GetCurrentFloor(int32 Index) const
+	{
+		FFindFloorResult Floor = CurrentFloor_Cold[Index];
+		GetCurrentFloorHotFields(Index, Floor);
+		return Floor;
+	}
+
+	/** Writes the hot fields of Floor to slot Index, leaving its cold record alone. */
+	void SetCurrentFloorHotFields(int32 Index, const FFindFloorResult& Floor)
+	{
+		CurrentFloor_bBlockingHit[Index] = Floor.bBlockingHit;
+		CurrentFloor_bWalkableFloor[Index] = Floor.bWalkableFloor;
+		CurrentFloor_bLineTrace[Index] = Floor.bLineTrace;
+		CurrentFloor_FloorDist[Index] = Floor.FloorDist;
+		CurrentFloor_LineDist[Index] = Floor.LineDist;
+		CurrentFloor_Time[Index] = Floor.HitResult.Time;
+		CurrentFloor_ImpactPoint[Index] = Floor.HitResult.ImpactPoint;
+		CurrentFloor_ImpactNormal[Index] = Floor.HitResult.ImpactNormal;
+	}
+
+	/** Points an FISPCMovementArrays at this store. Field order must match CppInterop.h. */
+	FISPCMovementArrays MakeArrays(bool bIsAdaptiveNetUpdateFrequencyEnabled, float WorldTimeSeconds, const FWalkableSlopeTable& WalkableSlopes)
+	{
+		return FISPCMovementArrays
+		{
+			bIsAdaptiveNetUpdateFrequencyEnabled,
+			WorldTimeSeconds,
+			&FCollisionResponseParams::DefaultResponseParam,
+			(uint32)sizeof(FCollisionQueryParams),
+			WalkableSlopes.MakeView(),
+
+			Comp.GetData(),
+			UpdatedComponent.GetData(),
+			DeferredUpdatedMoveComponent.GetData(),
+			UpdatedPrimitive.GetData(),
+			CharacterOwner.GetData(),
+			CharacterOwner_MovementBase.GetData(),
+			UpdatedComponent_Owner.GetData(),
+			CollisionQueryParams.GetData(),
+			CollisionResponseParams.GetData(),
+
+			UpdatedComponent_Mobility.GetData(),
+			CharacterOwner_Role.GetData(),
+			UpdatedComponent_IsSimulatingPhysics.GetData(),
+			CharacterOwner_bClientUpdating.GetData(),
+			CharacterOwner_IsPlayingRootMotion.GetData(),
+			CharacterOwner_bServerMoveIgnoreRootMotion.GetData(),
+			CharacterOwner_IsMatineeControlled.GetData(),
+			CharacterOwner_HasAuthority.GetData(),
+			CharacterOwner_GetMesh.GetData(),
+			NavAgentProps_bCanCrouch.GetData(),
+			DefaultCharacter_CapsuleComponent_UnscaledSize.GetData(),
+			UpdatedComponent_CollisionObjectType.GetData(),
+			PawnCapsuleCollisionShape_ShrinkCapsuleExtent_None.GetData(),
+			CurrentRootMotion_HasActiveRootMotionSources.GetData(),
+			RootMotionParams_bHasRootMotion.GetData(),
+
+			NetMode.GetData(),
+			bCrouchMaintainsBaseLocation.GetData(),
+			bWantsToCrouch.GetData(),
+			bWantsToLeaveNavWalking.GetData(),
+			bAllowPhysicsRotationDuringAnimRootMotion.GetData(),
+			CrouchedHalfHeight.GetData(),
+			GravityScale.GetData(),
+			BrakingFrictionFactor.GetData(),
+			MaxSimulationIterations.GetData(),
+			MoveComponentFlags.GetData(),
+
+			UpdatedComponent_ComponentScale.GetData(),
+			WalkableFloorZ.GetData(),
+			bScalarFallback.GetData(),
+
+			PhysicsVolume_GravityZ.GetData(),
+			PhysicsVolume_bWaterVolume.GetData(),
+			PhysicsVolume_FluidFriction.GetData(),
+			PhysicsVolume_TerminalVelocity.GetData(),
+
+			CurrentFloor_bBlockingHit.GetData(),
+			CurrentFloor_bWalkableFloor.GetData(),
+			CurrentFloor_bLineTrace.GetData(),
+			CurrentFloor_FloorDist.GetData(),
+			CurrentFloor_LineDist.GetData(),
+			CurrentFloor_Time.GetData(),
+			CurrentFloor_ImpactPoint.GetData(),
+			CurrentFloor_ImpactNormal.GetData(),
+			CurrentFloor_Cold.GetData(),
+			CurrentFloor_bColdDirty.GetData(),
+
+			MovementMode.GetData(),
+			CharacterOwner_bIsCrouched.GetData(),
+			CharacterOwner_CapsuleComponent_Size.GetData(),
+			UpdatedComponent_ComponentQuat.GetData(),
+			UpdatedComponent_ComponentLocation.GetData(),
+
+			PendingImpulseToApply.GetData(),
+			PendingForceToApply.GetData(),
+			PendingLaunchVelocity.GetData(),
+
+			bForceNextFloorCheck.GetData(),
+			bShrinkProxyCapsule.GetData(),
+			bDeferUpdateBasedMovement.GetData(),
+			bDeferUpdateMoveComponent.GetData(),
+			bHasRequestedVelocity.GetData(),
+			bMovementInProgress.GetData(),
+			bJustTeleported.GetData(),
+
+			LastUpdateLocation.GetData(),
+			LastUpdateRotation.GetData(),
+			LastUpdateVelocity.GetData(),
+			Velocity.GetData(),
+
+			ServerLastTransformUpdateTimeStamp.GetData(),
+		};
+	}
+};
+
+/** Backing store for FISPCPhysicsQueue. Only meaningful for the duration of a bucketed tick. */
+struct FISPCPhysicsQueueStore
+{
+	TArray<FVector> OldLocation;
+	TArray<FVector> OldVelocity;
+	TArray<bool> bPerformMovement;
+	TArray<float> RemainingTime;
+	TArray<int32> Iterations;
+	TArray<bool> bRequeued;
+
+	/** Component indices of the current bucketing pass, sorted by bucket. */
+	TArray<int32> Pending;
+	/** Bucket keys, parallel to the components. */
+	TArray<uint32> BucketKeys;
+
+	void SetNum(int32 Num)
+	{
+		// Every field is written by the PrePhysics() kernel before it's read.
+		OldLocation.SetNumUninitialized(Num, false);
+		OldVelocity.SetNumUninitialized(Num, false);
+		bPerformMovement.SetNumUninitialized(Num, false);
+		RemainingTime.SetNumUninitialized(Num, false);
+		Iterations.SetNumUninitialized(Num, false);
+		bRequeued.SetNumUninitialized(Num, false);
+		BucketKeys.SetNumUninitialized(Num, false);
+	}
+
+	FISPCPhysicsQueue MakeQueue()
+	{
+		return FISPCPhysicsQueue
+		{
+			OldLocation.GetData(),
+			OldVelocity.GetData(),
+			bPerformMovement.GetData(),
+			RemainingTime.GetData(),
+			Iterations.GetData(),
+			bRequeued.GetData(),
+		};
+	}
+};
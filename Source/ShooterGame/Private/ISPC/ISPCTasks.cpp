@@ -0,0 +1,88 @@
+#include "ShooterGame.h"
+#include "Async/TaskGraphInterfaces.h"
+
+// ISPC: Runtime for the ISPC task system (launch/sync), implemented on top of the task graph.
+
+DECLARE_CYCLE_STAT(TEXT("ISPC Task"), STAT_ISPCTask, STATGROUP_TaskGraphTasks);
+
+namespace
+{
+	/** Signature ISPC emits for task functions. */
+	typedef void (*FISPCTaskFunc)(void* Data, int ThreadIndex, int ThreadCount,
+		int TaskIndex, int TaskCount,
+		int TaskIndex0, int TaskIndex1, int TaskIndex2,
+		int TaskCount0, int TaskCount1, int TaskCount2);
+
+	/**
+	 * State behind the opaque handle ISPC keeps per function that launches tasks.
+	 * Only ever touched by the thread that owns the launching function, so no locking.
+	 */
+	struct FISPCTaskGroup
+	{
+		FGraphEventArray Events;
+		TArray<void*, TInlineAllocator<4>> Allocations;
+	};
+
+	FISPCTaskGroup& GetTaskGroup(void** HandlePtr)
+	{
+		if (*HandlePtr == nullptr)
+		{
+			*HandlePtr = new FISPCTaskGroup();
+		}
+		return *static_cast<FISPCTaskGroup*>(*HandlePtr);
+	}
+}
+
+extern "C"
+{
+	void* ISPCAlloc(void** HandlePtr, int64 Size, int32 Alignment)
+	{
+		FISPCTaskGroup& Group = GetTaskGroup(HandlePtr);
+		void* Memory = FMemory::Malloc(Size, Alignment);
+		Group.Allocations.Add(Memory);
+		return Memory;
+	}
+
+	void ISPCLaunch(void** HandlePtr, void* Func, void* Data, int CountX, int CountY, int CountZ)
+	{
+		FISPCTaskGroup& Group = GetTaskGroup(HandlePtr);
+		FISPCTaskFunc TaskFunc = reinterpret_cast<FISPCTaskFunc>(Func);
+		const int TaskCount = CountX * CountY * CountZ;
+
+		Group.Events.Reserve(Group.Events.Num() + TaskCount);
+		for (int TaskIndex = 0; TaskIndex < TaskCount; ++TaskIndex)
+		{
+			Group.Events.Add(FFunctionGraphTask::CreateAndDispatchWhenReady(
+				[=]()
+				{
+					const int TaskIndex0 = TaskIndex % CountX;
+					const int TaskIndex1 = (TaskIndex / CountX) % CountY;
+					const int TaskIndex2 = TaskIndex / (CountX * CountY);
+					// ISPC only uses the thread index to pick per-thread scratch storage; the task
+					// index is unique among concurrently running tasks, which is all it needs.
+					TaskFunc(Data, TaskIndex, TaskCount, TaskIndex, TaskCount,
+						TaskIndex0, TaskIndex1, TaskIndex2, CountX, CountY, CountZ);
+				},
+				GET_STATID(STAT_ISPCTask), nullptr, ENamedThreads::AnyThread));
+		}
+	}
+
+	void ISPCSync(void* Handle)
+	{
+		FISPCTaskGroup* Group = static_cast<FISPCTaskGroup*>(Handle);
+		if (Group == nullptr)
+		{
+			return;
+		}
+
+		// Waiting on the game thread's local queue lets it service game-thread-only callbacks
+		// that the tasks marshal over (see RunOnGameThread() in ShooterParallelMovement.h).
+		FTaskGraphInterface::Get().WaitUntilTasksComplete(Group->Events, IsInGameThread() ? ENamedThreads::GameThread_Local : ENamedThreads::AnyThread);
+
+		for (void* Memory : Group->Allocations)
+		{
+			FMemory::Free(Memory);
+		}
+		delete Group;
+	}
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "CppInterop.h"
+
+/**
+ * Walkable slope overrides of the primitives bots have hit, keyed by the primitive's FWeakObjectPtr so that the ISPC
+ * kernel can look up FHitResult::Component itself, see ModifyWalkableFloorZ() in the kernel. Open addressing with
+ * linear probing, kept at most half full.
+ *
+ * Read-only while the kernel runs. Primitives the kernel doesn't find go through the MaybeModifyWalkableFloorZ
+ * callback, which queues them; Flush() inserts them on the game thread before the next kernel run.
+ */
+class FWalkableSlopeTable
+{
+public:
+	/** Table of the system whose kernel is running, null otherwise. */
+	static FWalkableSlopeTable* Active;
+
+	/** Queues Primitive for insertion by the next Flush(), once however many lanes miss it. Safe on any thread. */
+	void AddPending(const UPrimitiveComponent* Primitive)
+	{
+		FScopeLock Lock(&PendingLock);
+		Pending.Add(Primitive);
+	}
+
+	/**
+	 * Drops the primitives that were destroyed or unregistered, picks up override changes of the others and inserts
+	 * the queued ones. Game thread only.
+	 */
+	void Flush()
+	{
+		bool bRemoved = false;
+		for (int32 Slot = 0; Slot < Primitives.Num(); ++Slot)
+		{
+			if (ObjectIndex[Slot] == INDEX_NONE)
+			{
+				continue;
+			}
+			const UPrimitiveComponent* Primitive = Primitives[Slot].Get();
+			if (Primitive == nullptr || !Primitive->IsRegistered())
+			{
+				bRemoved = true;
+				continue;
+			}
+			Bounds[Slot] = GetBounds(Primitive);
+		}
+
+		FScopeLock Lock(&PendingLock);
+		if (bRemoved || Primitives.Num() == 0 || (Num + Pending.Num()) * 2 > Primitives.Num())
+		{
+			// Removing from a probe chain would break it, so rehash the survivors instead.
+			for (int32 Slot = 0; Slot < Primitives.Num(); ++Slot)
+			{
+				const UPrimitiveComponent* Primitive = Primitives[Slot].Get();
+				if (ObjectIndex[Slot] != INDEX_NONE && Primitive != nullptr && Primitive->IsRegistered())
+				{
+					Pending.Add(Primitive);
+				}
+			}
+			Reset(FMath::Max(MinCapacity, (int32)FMath::RoundUpToPowerOfTwo(Pending.Num() * 2)));
+		}
+		for (const TWeakObjectPtr<const UPrimitiveComponent>& Primitive : Pending)
+		{
+			if (Primitive.IsValid())
+			{
+				Insert(Primitive.Get());
+			}
+		}
+		Pending.Reset();
+	}
+
+	int32 GetNum() const
+	{
+		return Num;
+	}
+
+	void Empty()
+	{
+		FScopeLock Lock(&PendingLock);
+		Pending.Empty();
+		ObjectIndex.Empty();
+		SerialNumber.Empty();
+		Bounds.Empty();
+		Primitives.Empty();
+		Num = 0;
+	}
+
+	/** The kernel's view of the table, valid until the next Flush(). */
+	FISPCWalkableSlopeTable MakeView() const
+	{
+		if (Primitives.Num() == 0)
+		{
+			// Never flushed: a single empty slot, so that lookups miss instead of faulting.
+			static const int32 EmptyObjectIndex = INDEX_NONE;
+			static const int32 EmptySerialNumber = 0;
+			static const FVector2D EmptyBounds(-BIG_NUMBER, BIG_NUMBER);
+			return FISPCWalkableSlopeTable{ &EmptyObjectIndex, &EmptySerialNumber, &EmptyBounds, 0 };
+		}
+		return FISPCWalkableSlopeTable{ ObjectIndex.GetData(), SerialNumber.GetData(), Bounds.GetData(), (uint32)Primitives.Num() - 1 };
+	}
+
+	/** Home slot of an object index, mirrored by the kernel. */
+	static uint32 Hash(int32 InObjectIndex, uint32 Mask)
+	{
+		return ((uint32)InObjectIndex * 0x9E3779B1u) & Mask;
+	}
+
+private:
+	static const int32 MinCapacity = 64;
+
+	/** Every override clamps the walkable floor Z into a range, found by probing it with both extremes. */
+	static FVector2D GetBounds(const UPrimitiveComponent* Primitive)
+	{
+		const FWalkableSlopeOverride& Override = Primitive->GetWalkableSlopeOverride();
+		return FVector2D(Override.ModifyWalkableFloorZ(-BIG_NUMBER), Override.ModifyWalkableFloorZ(BIG_NUMBER));
+	}
+
+	void Reset(int32 Capacity)
+	{
+		// Empty slots hold the key of a null FWeakObjectPtr and pass-through bounds, so null components resolve to no override.
+		ObjectIndex.Init(INDEX_NONE, Capacity);
+		SerialNumber.Init(0, Capacity);
+		Bounds.Init(FVector2D(-BIG_NUMBER, BIG_NUMBER), Capacity);
+		Primitives.Init(nullptr, Capacity);
+		Num = 0;
+	}
+
+	void Insert(const UPrimitiveComponent* Primitive)
+	{
+		const int32 InObjectIndex = GUObjectArray.ObjectToIndex(Primitive);
+		const int32 InSerialNumber = GUObjectArray.AllocateSerialNumber(InObjectIndex);
+		const uint32 Mask = (uint32)Primitives.Num() - 1;
+		uint32 Slot = Hash(InObjectIndex, Mask);
+		while (ObjectIndex[Slot] != INDEX_NONE)
+		{
+			if (ObjectIndex[Slot] == InObjectIndex && SerialNumber[Slot] == InSerialNumber)
+			{
+				// Already in the table.
+				return;
+			}
+			Slot = (Slot + 1) & Mask;
+		}
+		ObjectIndex[Slot] = InObjectIndex;
+		SerialNumber[Slot] = InSerialNumber;
+		Bounds[Slot] = GetBounds(Primitive);
+		Primitives[Slot] = Primitive;
+		++Num;
+	}
+
+	/** The kernel-visible part, see FISPCWalkableSlopeTable. */
+	TArray<int32> ObjectIndex;
+	TArray<int32> SerialNumber;
+	TArray<FVector2D> Bounds;
+	/** Primitive in each slot, for Flush(). */
+	TArray<TWeakObjectPtr<const UPrimitiveComponent>> Primitives;
+	int32 Num = 0;
+
+	TSet<TWeakObjectPtr<const UPrimitiveComponent>> Pending;
+	FCriticalSection PendingLock;
+};
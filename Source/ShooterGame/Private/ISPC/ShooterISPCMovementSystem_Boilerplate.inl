@@ -16,15 +16,27 @@
 #endif
 #define ensureMsgf(...)	// FIXME ISPC
 
-// TODO ISPC: Feed these back to C++?
+#include "CppInterop.h"
+#include "ISPCCycleStats.h"
+
+// ISPC: No destructors, so no scoped cycle counters either; ported code keeps SCOPE_CYCLE_COUNTER() as a no-op and
+// timed regions use an explicit CYCLE_COUNTER_BEGIN()/CYCLE_COUNTER_END() pair with a single exit instead. The
+// timestamp counter is read once per gang, and the delta goes into a per-thread buffer which the system flushes into
+// the STAT_Char* stat of the same name after the tick (see ISPCCycleStats.h).
 #define SCOPE_CYCLE_COUNTER(...)
+#define CYCLE_COUNTER_BEGIN(Stat)	const uniform int64 _CycleCounterStart_##Stat = clock()
+#define CYCLE_COUNTER_END(Stat)	ISPCCycleCounters_Add(ISPCCycleStat_##Stat, clock() - _CycleCounterStart_##Stat)
 
-#include "CppInterop.h"
+extern "C" void ISPCCycleCounters_Add(uniform int32 Stat, uniform int64 Timestamps);
 
 struct FISPCMovementContext
 {
 	uniform FISPCMovementArrays* Arrays;
 	varying int Index;
+	// Bucketed tick only, otherwise NULL. See StartNewPhysics().
+	uniform FISPCPhysicsQueue* Queue;
+	// Movement mode shared by all bots in the current bucket.
+	uniform EMovementMode BucketMode;
 };
 
 #define CtxAccess(Field)	(Ctx.Arrays->Field[Ctx.Index])
@@ -47,7 +59,6 @@ const uniform float VERTICAL_SLOPE_NORMAL_Z = 0.001f; // Slope is vertical if Ab
 
 const uniform FVector FVector_ZeroVector = { 0, 0, 0 };
 const uniform FQuat FQuat_Identity = { 0, 0, 0, 1 };
-static const uniform FCollisionResponseParams FCollisionResponseParams_DefaultResponseParam;	// FIXME ISPC
 inline FVector2D MakeFVector2D(float X, float Y) { FVector2D V = { X, Y }; return V; }
 inline FVector MakeFVector(float X, float Y, float Z) { FVector V = { X, Y, Z }; return V; }
 inline bool FVector_Equal(FVector A, FVector B) { return A.x == B.x && A.y == B.y && A.z == B.z; }
@@ -112,10 +123,130 @@ inline bool FFindFloorResult_bLineTrace(const FFindFloorResult* Floor)
 	return 0 != (Floor->bBlockingHit_bWalkableFloor_bLineTrace & 0b100);
 }
 
+// ISPC: CurrentFloor is stored hot/cold (see FISPCMovementArrays). Code that only needs the hot fields reads them
+// directly, e.g. CtxAccess(CurrentFloor_FloorDist); these two assemble and write back the whole record.
+inline FFindFloorResult LoadCurrentFloor(FISPCMovementContext Ctx)
+{
+	FFindFloorResult Floor = CtxAccess(CurrentFloor_Cold);
+	Floor.bBlockingHit_bWalkableFloor_bLineTrace = (Floor.bBlockingHit_bWalkableFloor_bLineTrace & ~0b111)
+		| (CtxAccess(CurrentFloor_bBlockingHit) ? 0b001 : 0)
+		| (CtxAccess(CurrentFloor_bWalkableFloor) ? 0b010 : 0)
+		| (CtxAccess(CurrentFloor_bLineTrace) ? 0b100 : 0);
+	Floor.FloorDist = CtxAccess(CurrentFloor_FloorDist);
+	Floor.LineDist = CtxAccess(CurrentFloor_LineDist);
+	Floor.HitResult.Time = CtxAccess(CurrentFloor_Time);
+	const FVector ImpactPoint = CtxAccess(CurrentFloor_ImpactPoint);
+	Floor.HitResult.ImpactPoint[0] = ImpactPoint.x;
+	Floor.HitResult.ImpactPoint[1] = ImpactPoint.y;
+	Floor.HitResult.ImpactPoint[2] = ImpactPoint.z;
+	const FVector ImpactNormal = CtxAccess(CurrentFloor_ImpactNormal);
+	Floor.HitResult.ImpactNormal[0] = ImpactNormal.x;
+	Floor.HitResult.ImpactNormal[1] = ImpactNormal.y;
+	Floor.HitResult.ImpactNormal[2] = ImpactNormal.z;
+	return Floor;
+}
+inline void StoreCurrentFloor(FISPCMovementContext Ctx, const FFindFloorResult& Floor)
+{
+	CtxAccess(CurrentFloor_bBlockingHit) = FFindFloorResult_bBlockingHit(&Floor);
+	CtxAccess(CurrentFloor_bWalkableFloor) = FFindFloorResult_bWalkableFloor(&Floor);
+	CtxAccess(CurrentFloor_bLineTrace) = FFindFloorResult_bLineTrace(&Floor);
+	CtxAccess(CurrentFloor_FloorDist) = Floor.FloorDist;
+	CtxAccess(CurrentFloor_LineDist) = Floor.LineDist;
+	CtxAccess(CurrentFloor_Time) = Floor.HitResult.Time;
+	CtxAccess(CurrentFloor_ImpactPoint) = MakeFVector(Floor.HitResult.ImpactPoint[0], Floor.HitResult.ImpactPoint[1], Floor.HitResult.ImpactPoint[2]);
+	CtxAccess(CurrentFloor_ImpactNormal) = MakeFVector(Floor.HitResult.ImpactNormal[0], Floor.HitResult.ImpactNormal[1], Floor.HitResult.ImpactNormal[2]);
+	CtxAccess(CurrentFloor_Cold) = Floor;
+	CtxAccess(CurrentFloor_bColdDirty) = true;
+}
+// ISPC: FFindFloorResult::IsWalkableFloor() and GetDistanceToFloor() of CurrentFloor, from the hot fields only.
+inline bool IsCurrentFloorWalkable(FISPCMovementContext Ctx)
+{
+	return CtxAccess(CurrentFloor_bBlockingHit) && CtxAccess(CurrentFloor_bWalkableFloor);
+}
+inline float GetCurrentFloorDistance(FISPCMovementContext Ctx)
+{
+	return CtxAccess(CurrentFloor_bLineTrace) ? CtxAccess(CurrentFloor_LineDist) : CtxAccess(CurrentFloor_FloorDist);
+}
+
+// ISPC: Batched scene queries. Instead of calling into C++ once per active lane, every active lane stages
+// its request in a gang-wide buffer and the whole batch is resolved by a single call. The query params are
+// passed as handles into the system's pool (GetQueryParams() etc.), never copied.
+// A batch is one gang, at most programCount requests: the kernel waits on the result in place, so queries are
+// not collected across gangs or frames. Of the converted call sites only the Crouch()/UnCrouch() encroachment
+// tests, the short capsule sweep in UnCrouch() and OverlapTest() are live; the floor and ledge sweeps are UNIMPLEMENTED_CODE.
+extern "C" void SweepSingleByChannelBatch_CppCallback(const uniform FCollisionQueryRequest* uniform Requests, uniform FHitResult* uniform OutHits, uniform bool* uniform OutBlockingHits, uniform int32 Count);
+extern "C" void OverlapBlockingTestByChannelBatch_CppCallback(const uniform FCollisionQueryRequest* uniform Requests, uniform bool* uniform OutBlockingHits, uniform int32 Count);
+
+struct FCollisionQueryBatch
+{
+	FCollisionQueryRequest Requests[programCount];
+	FHitResult Hits[programCount];
+	bool BlockingHits[programCount];
+};
+
+/** Compacts the active lanes' requests into the front of the batch. Returns the calling lane's slot. */
+inline int StageCollisionQuery(uniform FCollisionQueryBatch& Batch, const void* _Comp, const FVector Start, const FVector End, const FQuat Rot,
+	ECollisionChannel TraceChannel, const FCollisionShape& CollisionShape, const /*FCollisionQueryParams**/void* _Params, const /*FCollisionResponseParams**/void* _ResponseParam)
+{
+	const int Slot = exclusive_scan_add(1);
+	Batch.Requests[Slot].Rot = Rot;
+	Batch.Requests[Slot].Start = Start;
+	Batch.Requests[Slot].End = End;
+	Batch.Requests[Slot].CollisionShape = CollisionShape;
+	Batch.Requests[Slot].Comp = _Comp;
+	Batch.Requests[Slot].Params = _Params;
+	Batch.Requests[Slot].ResponseParam = _ResponseParam;
+	Batch.Requests[Slot].TraceChannel = (uint8)TraceChannel;
+	return Slot;
+}
+
+bool SweepSingleByChannelBatched(const void* _Comp, FHitResult& OutHit, const FVector Start, const FVector End, const FQuat Rot,
+	ECollisionChannel TraceChannel, const FCollisionShape& CollisionShape, const /*FCollisionQueryParams**/void* _Params, const /*FCollisionResponseParams**/void* _ResponseParam)
+{
+	uniform FCollisionQueryBatch Batch;
+	const int Slot = StageCollisionQuery(Batch, _Comp, Start, End, Rot, TraceChannel, CollisionShape, _Params, _ResponseParam);
+	SweepSingleByChannelBatch_CppCallback(Batch.Requests, Batch.Hits, Batch.BlockingHits, reduce_add(1));
+	OutHit = Batch.Hits[Slot];
+	return Batch.BlockingHits[Slot];
+}
+
+bool OverlapBlockingTestByChannelBatched(const void* _Comp, const FVector Pos, const FQuat Rot,
+	ECollisionChannel TraceChannel, const FCollisionShape& CollisionShape, const /*FCollisionQueryParams**/void* _Params, const /*FCollisionResponseParams**/void* _ResponseParam)
+{
+	uniform FCollisionQueryBatch Batch;
+	const int Slot = StageCollisionQuery(Batch, _Comp, Pos, Pos, Rot, TraceChannel, CollisionShape, _Params, _ResponseParam);
+	OverlapBlockingTestByChannelBatch_CppCallback(Batch.Requests, Batch.BlockingHits, reduce_add(1));
+	return Batch.BlockingHits[Slot];
+}
+
+
+// ISPC: Transform and capsule reads go to the per-frame snapshot gathered by the system. Moves of the updated
+// component go through MoveComponent(Ctx, ...), which keeps the snapshot in sync.
+inline FVector GetUpdatedComponentLocation(FISPCMovementContext Ctx)
+{
+	return CtxAccess(UpdatedComponent_ComponentLocation);
+}
+
+inline bool MoveComponent(FISPCMovementContext Ctx, const FVector Delta, const FQuat NewRotation, bool bSweep, FHitResult* OutHit, uint8 MoveFlags, uint8 Teleport)
+{
+	return MoveComponent(CtxAccess(UpdatedComponent), Delta, NewRotation, bSweep, OutHit, MoveFlags, Teleport,
+		&CtxAccess(UpdatedComponent_ComponentLocation), &CtxAccess(UpdatedComponent_ComponentQuat));
+}
+
+inline float GetScaledCapsuleRadius(FISPCMovementContext Ctx)
+{
+	return CtxAccess(CharacterOwner_CapsuleComponent_Size).x * CtxAccess(CharacterOwner_CapsuleComponent_Size).z;
+}
+
+inline float GetScaledCapsuleHalfHeight(FISPCMovementContext Ctx)
+{
+	return CtxAccess(CharacterOwner_CapsuleComponent_Size).y * CtxAccess(CharacterOwner_CapsuleComponent_Size).z;
+}
 
-FVector GetUpdatedComponentLocation(FISPCMovementContext Ctx)
+inline void GetScaledCapsuleSize(FISPCMovementContext Ctx, float& OutRadius, float& OutHalfHeight)
 {
-	return GetUpdatedComponentLocation(CtxAccess(Comp));
+	OutRadius = GetScaledCapsuleRadius(Ctx);
+	OutHalfHeight = GetScaledCapsuleHalfHeight(Ctx);
 }
 
 // Forward declarations.
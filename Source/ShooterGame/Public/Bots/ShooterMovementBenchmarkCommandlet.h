@@ -0,0 +1,34 @@
+/**
+ * Headless benchmark of the bot movement systems.
+ */
+
+#pragma once
+#include "Commandlets/Commandlet.h"
+#include "GameFramework/Character.h"
+#include "ShooterMovementBenchmarkCommandlet.generated.h"
+
+/** Bare character driven by the unrolled movement component. No meshes, no AI, nothing to load. */
+UCLASS(NotPlaceable, Transient)
+class AShooterBenchmarkBot : public ACharacter
+{
+	GENERATED_UCLASS_BODY()
+};
+
+/**
+ * Runs N bots for M frames in a transient world made of a floor and a box soup, and reports the movement
+ * system's cost in ns/bot/frame, the C++ callbacks made by the ISPC kernel per frame and the kernel's lane
+ * utilisation, for the dispatched target and then for every target of a multi-target build this CPU supports.
+ * Needs neither content nor a GPU:
+ *
+ *   UE4Editor-Cmd ISPCShooterGame -run=ShooterMovementBenchmark -nullrhi -Bots=512 -Frames=600 -Impl=2
+ *
+ * Parameters (all optional): Bots, Frames, Warmup (frames excluded from the results), Impl (value of
+ * ispc.MovementImplementation, 1 or 2), Boxes, Seed, DeltaTime.
+ */
+UCLASS()
+class UShooterMovementBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+	virtual int32 Main(const FString& Params) override;
+};
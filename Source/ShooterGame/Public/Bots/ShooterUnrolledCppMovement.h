@@ -11,6 +11,82 @@
 	#define EMIT_FORWARD_DECLARATIONS
 	#include "ISPC/CppCallbacks.inl"
 	#undef EMIT_FORWARD_DECLARATIONS
+	#include "ISPC/ISPCMovementStore.h"
+	#include "Bots/ShooterParallelMovement.h"
+	#include "Bots/ShooterMovementEvents.h"
+	#include "Bots/ShooterBotBroadphase.h"
+
+/** A bot's last floor sweep, see UShooterUnrolledCppMovementSystem::FindCachedFloor(). */
+struct FFloorCache
+{
+	FFindFloorResult Floor;
+	/** Capsule location the sweep was made from. */
+	FVector CapsuleLocation = FVector::ZeroVector;
+	/** Transform of the floor primitive at the time of the sweep. */
+	FVector FloorLocation = FVector::ZeroVector;
+	FQuat FloorRotation = FQuat::Identity;
+	/** Collision geometry version the sweep saw, 0 if the cache is empty. */
+	uint32 GeometryVersion = 0;
+};
+
+/** Top face of a box-shaped floor primitive, see UShooterUnrolledCppMovementSystem::AnalyticFloorSweep(). */
+struct FAnalyticFloor
+{
+	/** Primitive the face was taken from, and the collision geometry version it was taken at. */
+	TWeakObjectPtr<UPrimitiveComponent> Primitive;
+	uint32 GeometryVersion = 0;
+	/** False if the primitive's collision isn't a single box. */
+	bool bValid = false;
+	FVector Center = FVector::ZeroVector;
+	FVector Normal = FVector::UpVector;
+	/** Edges of the face and their half lengths. */
+	FVector AxisX = FVector::ForwardVector;
+	FVector AxisY = FVector::RightVector;
+	float HalfX = 0.f;
+	float HalfY = 0.f;
+};
+
+/** A bot's movement level of detail, see UShooterUnrolledCppMovementSystem::UpdateMovementLOD(). */
+struct FMovementLODState
+{
+	/** The bot ticks every (1 << RateShift) frames. */
+	uint8 RateShift = 0;
+	/** Set when the bot is picked for a reduced-rate tick with interpolation, until its mesh offset is updated. */
+	bool bInterpolateTick = false;
+	/** Frame time accumulated since the bot's last tick. */
+	float AccumulatedTime = 0.f;
+	/** Capsule transform before the current tick. */
+	FVector PrevLocation = FVector::ZeroVector;
+	FQuat PrevRotation = FQuat::Identity;
+	/** Offset of the rendered mesh from the capsule (world space, and rotation in capsule space), blended out over InterpRemaining. */
+	FVector MeshOffset = FVector::ZeroVector;
+	FQuat MeshRotationOffset = FQuat::Identity;
+	float InterpRemaining = 0.f;
+};
+
+/** Collision settings a bot's capsule had before it joined the bot broadphase, see UShooterUnrolledCppMovementSystem::UpdateBotBroadphase(). */
+struct FBotBroadphaseState
+{
+	/** Capsule whose object type was switched to the bot channel, null while the bot isn't in the broadphase. */
+	TWeakObjectPtr<UPrimitiveComponent> Primitive;
+	ECollisionChannel Channel = ECC_MAX;
+	ECollisionChannel SavedObjectType = ECC_Pawn;
+	ECollisionResponse SavedBotChannelResponse = ECR_Block;
+};
+
+/** A bot's scene query params, see UShooterUnrolledCppMovementSystem::GetCollisionParams(). */
+struct FPooledCollisionParams
+{
+	/** Identical but for the trace tag of each call site, indexed by EBotQuerySite. */
+	FCollisionQueryParams QueryParams[BQS_MAX];
+	FCollisionResponseParams ResponseParams;
+	/** Updated primitive and ignored owner the params were built for. */
+	const UPrimitiveComponent* Primitive = nullptr;
+	const AActor* IgnoreActor = nullptr;
+	/** Hash of the primitive's sweep collision settings at the time of the build, which is all that can invalidate the params. */
+	uint32 SettingsHash = 0;
+	bool bBuilt = false;
+};
 #endif
 
 UCLASS()
@@ -21,6 +97,8 @@ class UShooterUnrolledCppMovement : public UShooterCharacterMovement
 public:
 	virtual void InitializeComponent() override;
 	virtual void UninitializeComponent() override;
+	/** Also refreshes the physics volume snapshot the movement system keeps for this bot. */
+	virtual void PhysicsVolumeChanged(class APhysicsVolume* NewVolume) override;
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 
 	virtual void VisualizeMovement() const override;
@@ -30,7 +108,16 @@ public:
 
 	friend class UShooterUnrolledCppMovementSystem;
 
+private:
+	/** Index into the owning system's Components (and its SoA stores), INDEX_NONE while unregistered. */
+	int32 SystemIndex;
+
 #if CPP	// Ignore in Unreal Header Tool.
+	FFloorCache FloorCache;
+	FAnalyticFloor AnalyticFloor;
+	FMovementLODState MovementLOD;
+	FBotBroadphaseState BotBroadphase;
+
 	#define EMIT_FRIEND_DECLARATIONS
 	#include "ISPC/CppCallbacks.inl"
 	#undef EMIT_FRIEND_DECLARATIONS
@@ -62,6 +149,34 @@ struct TStructOpsTypeTraits<FSystemTickFunction> : public TStructOpsTypeTraitsBa
 	};
 };
 
+#if CPP	// Ignore in Unreal Header Tool.
+/** A NavWalking step split around its navmesh projection, so that the projections of many bots can be batched. */
+struct FNavWalkingMove
+{
+	UShooterUnrolledCppMovement* Comp = nullptr;
+	float DeltaTime = 0.f;
+	int32 Iterations = 0;
+	/** Feet location at the start of the step. */
+	FVector OldLocation = FVector::ZeroVector;
+	FVector DeltaMove = FVector::ZeroVector;
+	/** Destination to project onto the navmesh. */
+	FVector AdjustedDest = FVector::ZeroVector;
+	FNavLocation DestNavLocation;
+	/** False if CachedNavLocation is reused as DestNavLocation. */
+	bool bNeedsProjection = false;
+	/** Result of the projection, false if there is no navigation data. */
+	bool bHasNavigationData = false;
+
+	// Bookkeeping of UShooterUnrolledCppMovementSystem::TickNavWalkingBatched().
+	FVector PerformOldLocation = FVector::ZeroVector;
+	FVector PerformOldVelocity = FVector::ZeroVector;
+	bool bPerformMovement = false;
+	bool bInPhysics = false;
+	bool bSavedMovementInProgress = false;
+	bool bPending = false;
+};
+#endif
+
 UCLASS()
 class UShooterUnrolledCppMovementSystem : public UObject
 {
@@ -73,8 +188,43 @@ public:
 	void RegisterComponent(UShooterUnrolledCppMovement* Comp);
 	void UnregisterComponent(UShooterUnrolledCppMovement* Comp);
 
+	/** Batched versions of the above for mass spawns and despawns. Storage is grown at most once per call. */
+	void RegisterComponents(const TArray<UShooterUnrolledCppMovement*>& Comps);
+	void UnregisterComponents(const TArray<UShooterUnrolledCppMovement*>& Comps);
+
 	void Tick(float DeltaTime);
 
+	/** Name of the instruction set the ISPC kernel was dispatched to on this machine. */
+	static const TCHAR* GetISPCTargetName();
+	/** Name of an instruction set as numbered by the kernel's GetTargetISA(). */
+	static const TCHAR* GetISPCTargetName(int32 ISA);
+
+	/** Returns the system ticking the given level's bots, if there is one. */
+	static UShooterUnrolledCppMovementSystem* FindForLevel(const ULevel* Level);
+
+	/** Drops all bots' cached floors, see FindCachedFloor(). Call after changing collision geometry bots may stand on. */
+	static void InvalidateFloorCaches();
+
+#if CPP	// Ignore in Unreal Header Tool.
+	/**
+	 * Opts an event type out of the movement event queue, for game code that must see it from within the movement
+	 * tick. Immediate events are marshalled to the game thread (or deferred) like other game-thread-only calls.
+	 */
+	static void SetImmediateMovementEvent(EMovementEventType Type, bool bImmediate);
+#endif
+
+	/** Duration of the last Tick(), in cycles. */
+	uint64 GetLastTickCycles() const { return LastTickCycles; }
+
+	/** Number of registered components. */
+	int32 GetNumComponents() const { return Components.Num(); }
+
+	/** Runs the ISPC kernel over all registered components (ispc.MovementImplementation=2). */
+	void TickISPC(float DeltaTime);
+
+	/** Runs PerformMovement() for this frame's bots (see UpdateMovementLOD()) on task graph workers (ispc.CppMovementParallel=1). */
+	void TickParallel(float DeltaTime);
+
 	//~ Begin UObject interface.
 	virtual void BeginDestroy() override;
 	//~ End UObject interface.
@@ -86,6 +236,10 @@ public:
 	/** changes physics based on MovementMode */
 	void StartNewPhysics(UShooterUnrolledCppMovement* Comp, float deltaTime, int32 Iterations);
 
+	/** The parts of StartNewPhysics() around the per-mode physics. BeginNewPhysics() returns false if there's nothing to simulate. */
+	bool BeginNewPhysics(UShooterUnrolledCppMovement* Comp, float deltaTime, int32 Iterations, bool& bOutSavedMovementInProgress);
+	void EndNewPhysics(UShooterUnrolledCppMovement* Comp, bool bSavedMovementInProgress);
+
 	/**
 	 * Change movement mode.
 	 *
@@ -193,6 +347,12 @@ public:
 
 	APhysicsVolume* GetPhysicsVolume(UShooterUnrolledCppMovement* Comp) const;
 
+	/**
+	 * Copies the gravity and fluid state of the bot's physics volume to the snapshot read by both implementations.
+	 * Called on registration and when the volume or the world's gravity changes instead of every frame.
+	 */
+	void UpdatePhysicsVolumeSnapshot(UShooterUnrolledCppMovement* Comp);
+
 	/** Return true if we have a valid CharacterOwner and UpdatedComponent. */
 	bool HasValidData(const UShooterUnrolledCppMovement* Comp) const;
 
@@ -233,6 +393,9 @@ public:
 	 */
 	bool FindNavFloor(UShooterUnrolledCppMovement* Comp, const FVector& TestLocation, FNavLocation& NavFloorLocation) const;
 
+	/** Query extent of FindNavFloor(), from the agent's properties. */
+	FVector GetNavFloorExtent(UShooterUnrolledCppMovement* Comp) const;
+
 	/** @return true if component can swim */
 	FORCEINLINE bool CanEverSwim(UShooterUnrolledCppMovement* Comp) const { return Comp->NavAgentProps.bCanSwim; }
 
@@ -240,6 +403,15 @@ protected:
 	/** Perform movement on an autonomous client */
 	void PerformMovement(UShooterUnrolledCppMovement* Comp, float DeltaTime);
 
+	/**
+	 * PerformMovement() split around StartNewPhysics(), so that the system can run the physics step of several bots in
+	 * passes. PerformMovement_Begin() returns false if the bot doesn't move this frame.
+	 */
+	bool PerformMovement_Begin(UShooterUnrolledCppMovement* Comp, float DeltaSeconds);
+	void PerformMovement_PrePhysics(UShooterUnrolledCppMovement* Comp, float DeltaSeconds, FVector& OldLocation, FVector& OldVelocity);
+	void PerformMovement_PostPhysics(UShooterUnrolledCppMovement* Comp, float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity);
+	void PerformMovement_End(UShooterUnrolledCppMovement* Comp, float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity);
+
 	/** @note Movement update functions should only be called through StartNewPhysics()*/
 	void PhysWalking(UShooterUnrolledCppMovement* Comp, float deltaTime, int32 Iterations);
 
@@ -267,6 +439,15 @@ protected:
 	 */
 	void StartSwimming(UShooterUnrolledCppMovement* Comp, FVector OldLocation, FVector OldVelocity, float timeTick, float remainingTime, int32 Iterations);
 
+	/** Moves the swimming bot by Delta, stopping at the water line if it leaves the water. @return fraction of the move spent out of the water. */
+	float Swim(UShooterUnrolledCppMovement* Comp, FVector Delta, FHitResult& Hit);
+
+	/** Get as close to waterline as possible, staying on same side as currently. */
+	FVector FindWaterLine(UShooterUnrolledCppMovement* Comp, FVector Start, FVector End);
+
+	/** @return how far the capsule is submerged in its water volume, 0 (out of water) to 1. */
+	float ImmersionDepth(UShooterUnrolledCppMovement* Comp) const;
+
 	/** Transition from walking to falling */
 	void StartFalling(UShooterUnrolledCppMovement* Comp, int32 Iterations, float remainingTime, float timeTick, const FVector& Delta, const FVector& subLoc);
 
@@ -281,6 +462,15 @@ protected:
 	 */
 	void FindFloor(UShooterUnrolledCppMovement* Comp, const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult, bool bZeroDelta, const FHitResult* DownwardSweepResult = nullptr) const;
 
+	/**
+	 * Temporal floor cache. FindFloor() reuses the last sweep while the capsule stays within ispc.FloorCacheTolerance
+	 * of where it was made, as long as the floor is flat and its primitive hasn't moved. Teleports, bForceNextFloorCheck
+	 * and InvalidateFloorCaches() force a new sweep.
+	 * @return true if OutFloorResult was filled in from the cache.
+	 */
+	bool FindCachedFloor(UShooterUnrolledCppMovement* Comp, const FVector& CapsuleLocation, FFindFloorResult& OutFloorResult) const;
+	void CacheFloor(UShooterUnrolledCppMovement* Comp, const FVector& CapsuleLocation, const FFindFloorResult& FloorResult) const;
+
 	/**
 	 * Compute distance to the floor from bottom sphere of capsule and store the result in OutFloorResult.
 	 * This distance is the swept distance of the capsule to the first point impacted by the lower hemisphere, or distance from the bottom of the capsule in the case of a line trace.
@@ -320,6 +510,13 @@ protected:
 		const struct FCollisionResponseParams& ResponseParam
 		) const;
 
+	/**
+	 * FloorSweepTest() without a physics query, for capsule sweeps straight down onto the top face of the bot's current
+	 * floor when that is a static box (ispc.AnalyticFloor). Returns false to fall back to a real sweep: near the edges
+	 * of the face, when starting in penetration and when the face is out of reach. Other geometry is not considered.
+	 */
+	bool AnalyticFloorSweep(UShooterUnrolledCppMovement* Comp, FHitResult& OutHit, const FVector& Start, const FVector& End, ECollisionChannel TraceChannel, const FCollisionShape& CollisionShape, const FCollisionResponseParams& ResponseParam) const;
+
 	/** Check if pawn is falling */
 	bool CheckFall(UShooterUnrolledCppMovement* Comp, const FFindFloorResult& OldFloor, const FHitResult& Hit, const FVector& Delta, const FVector& OldLocation, float remainingTime, float timeTick, int32 Iterations, bool bMustJump);
 
@@ -360,6 +557,9 @@ protected:
 	/** Notification that the character is stuck in geometry.  Only called during walking movement. */
 	void OnCharacterStuckInGeometry(UShooterUnrolledCppMovement* Comp, const FHitResult* Hit);
 
+	/** Logs the warning of OnCharacterStuckInGeometry(). */
+	void LogStuckInGeometry(UShooterUnrolledCppMovement* Comp, const FHitResult* Hit, const FVector& Velocity, int32 EventsSinceNotify) const;
+
 	/**
 	 * Adjusts velocity when walking so that Z velocity is zero.
 	 * When bMaintainHorizontalGroundVelocity is false, also rescales the velocity vector to maintain the original magnitude, but in the horizontal direction.
@@ -574,6 +774,9 @@ protected:
 	/** Handle a blocking impact. Calls ApplyImpactPhysicsForces for the hit, if bEnablePhysicsInteraction is true. */
 	void HandleImpact(UShooterUnrolledCppMovement* Comp, const FHitResult& Hit, float TimeSlice=0.f, const FVector& MoveDelta = FVector::ZeroVector);
 
+	/** The notifications of HandleImpact(), with the acceleration and velocity for impact forces captured at the impact. */
+	void DeliverImpact(UShooterUnrolledCppMovement* Comp, const FHitResult& Hit, float TimeSlice, const FVector& MoveDelta, const FVector& ImpactAcceleration, const FVector& ImpactVelocity);
+
 	/**
 	 * Apply physics forces to the impacted component, if bEnablePhysicsInteraction is true.
 	 * @param Impact				HitResult that resulted in the impact
@@ -664,6 +867,124 @@ protected:
 	void CallMovementUpdateDelegate(UShooterUnrolledCppMovement* Comp, float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity);
 
 protected:
+	/** Refreshes the SoA store from the registered components before the ISPC kernel runs. */
+	void GatherISPCStore();
+
+	/** Writes kernel results back to the components, touching only the fields that actually changed. */
+	void ScatterISPCStore();
+
+	uint64 LastTickCycles;
+
+	/** Dense registry. Removal swaps the last component into the hole, see UShooterUnrolledCppMovement::SystemIndex. */
 	UPROPERTY()
 	TArray<UShooterUnrolledCppMovement*> Components;
+
+#if CPP	// Ignore in Unreal Header Tool.
+	/** Dense per-field arrays fed to the ISPC kernel, parallel to Components. */
+	FISPCMovementStore ISPCStore;
+
+	/** World gravity the physics volume snapshots were taken with, see UpdatePhysicsVolumeSnapshot(). */
+	float LastWorldGravityZ = 0.f;
+
+	/** Walkable slope overrides of the components bots hit, looked up by the ISPC kernel. Flushed before each kernel run. */
+	FWalkableSlopeTable WalkableSlopes;
+
+	/** Bots in movement modes the ISPC kernel doesn't implement, moved by PerformMovement() after the kernel. Filled by GatherISPCStore(). */
+	TArray<UShooterUnrolledCppMovement*> ISPCScalarBots;
+
+	/** Runs the ISPC kernel as PrePhysics, per-movement-mode buckets and PostPhysics (ispc.MovementBucketing=1), each in tasks of ChunkSize bots if > 0. */
+	void TickISPCBucketed(float DeltaSeconds, FISPCMovementArrays& Arrays, int32 ChunkSize);
+
+	/** Scratch state of TickISPCBucketed(), parallel to Components. */
+	FISPCPhysicsQueueStore ISPCPhysicsQueue;
+
+	/** Per-worker buffers of game-thread-only work deferred during TickParallel(). */
+	TArray<FMovementCommandBuffer> CommandBuffers;
+
+	/** Notifications into actor code made during Tick(), delivered at its end by DeliverMovementEvents(). */
+	FMovementEventQueue MovementEvents;
+
+	/** Event types opted out of the queue by game code, see SetImmediateMovementEvent(). */
+	static uint32 ImmediateMovementEvents;
+
+	void DeliverMovementEvents();
+	void DeliverMovementEvent(const FMovementEvent& Event);
+
+	/**
+	 * Moves all NavWalking bots, with their navmesh projections batched: every bot runs up to the projection, then
+	 * FindNavFloors() projects all destinations at once, then every bot finishes its step (ispc.CppNavWalkingBatching=1).
+	 */
+	void TickNavWalkingBatched();
+
+	/** First and second half of PhysNavWalking(). BeginPhysNavWalking() returns false if the step ended early. */
+	bool BeginPhysNavWalking(UShooterUnrolledCppMovement* Comp, float deltaTime, int32 Iterations, FNavWalkingMove& OutMove);
+	void FinishPhysNavWalking(const FNavWalkingMove& Move);
+
+	/** FindNavFloor() for all moves needing a projection, in one ProjectPoint batch per navigation data and extent. */
+	void FindNavFloors(TArray<FNavWalkingMove>& Moves) const;
+
+	/** Scratch state of TickNavWalkingBatched(). */
+	TArray<UShooterUnrolledCppMovement*> NavWalkingBots;
+	TArray<float> NavWalkingDeltaSeconds;
+	TArray<FNavWalkingMove> NavWalkingMoves;
+
+	/**
+	 * Picks the bots the unrolled C++ tick moves this frame into TickComponents. With ispc.MovementLOD, bots far from
+	 * every player tick at 1/2, 1/4 or 1/8 rate, staggered across frames, with the frame time accumulated in between.
+	 */
+	void UpdateMovementLOD(float DeltaSeconds);
+
+	/**
+	 * Puts every bot back at full rate and queues the meshes still blending into LODInterpolatingBots, so that the next
+	 * InterpolateMovementLOD() snaps them onto their capsules. Drops the accumulated time; hand it out first if needed.
+	 */
+	void ResetMovementLOD();
+
+	/** Blends the meshes of reduced-rate bots from where they were rendered towards their capsules (ispc.MovementLODInterpolation). */
+	void InterpolateMovementLOD(float DeltaSeconds);
+
+	/** Bots to move this frame and their time steps, see UpdateMovementLOD(). */
+	TArray<UShooterUnrolledCppMovement*> TickComponents;
+	TArray<float> TickDeltaSeconds;
+
+	/** Bots whose meshes InterpolateMovementLOD() updates this frame. */
+	TArray<UShooterUnrolledCppMovement*> LODInterpolatingBots;
+
+	/** Player view locations the LOD distances are measured from. */
+	TArray<FVector> LODViewLocations;
+	uint32 LODFrameCounter = 0;
+	bool bMovementLODActive = false;
+
+	/**
+	 * Bot-vs-bot contacts without PhysX (ispc.BotBroadphase, unrolled C++ only). Bot capsules are moved to a collision
+	 * channel they ignore, so movement sweeps only hit the world; MoveUpdatedComponent() stops at other bots analytically
+	 * and the overlap tests check them with OverlapBots().
+	 */
+	void UpdateBotBroadphase(bool bEnable);
+	void SetBotBroadphaseCollision(UShooterUnrolledCppMovement* Comp, bool bEnable);
+
+	/** MoveUpdatedComponent() for a sweep that reaches another bot's capsule first, OutHit is filled in for that bot. */
+	bool MoveUpdatedComponentToBot(UShooterUnrolledCppMovement* Comp, const FVector& Delta, const FQuat& NewRotation, FHitResult* OutHit, ETeleportType Teleport, const FBotContact& Contact);
+
+	/** Overlap of Comp's capsule shape at Location with other bots, which the PhysX overlap tests no longer see. */
+	bool OverlapBots(UShooterUnrolledCppMovement* Comp, const FVector& Location, const FCollisionShape& CollisionShape) const;
+
+	FBotBroadphase BotBroadphase;
+	/** Scratch for UpdateBotBroadphase(), parallel to Components. */
+	TArray<FBotCapsule> BotCapsules;
+	/** Object type bot capsules were switched to, ECC_MAX while the broadphase is off. */
+	ECollisionChannel BotBroadphaseChannel = ECC_MAX;
+
+	/** Rebuilds the pooled collision params of the bots whose collision settings changed since the last tick. */
+	void RefreshCollisionParams();
+
+	/** Rebuilds Entry if it wasn't built for Comp's current primitive and owner or, with bCheckSettings, if their settings changed. */
+	void UpdateCollisionParams(UShooterUnrolledCppMovement* Comp, FPooledCollisionParams& Entry, bool bCheckSettings) const;
+
+	/** The bot's pooled params, equivalent to InitCollisionParams() on params ignoring CharacterOwner. */
+	const FPooledCollisionParams& GetCollisionParams(UShooterUnrolledCppMovement* Comp) const;
+
+	/** Scene query params of each bot, parallel to Components. Entries are only ever touched on behalf of their own bot. */
+	mutable TArray<FPooledCollisionParams> CollisionParamsPool;
+#endif
 };
@@ -10,8 +10,11 @@ public class ShooterGame : ModuleRules
 	// Minimum supported ISPC version.
 	public static readonly System.Version MinimumISPCVersion = new System.Version(1, 9, 3);
 	public static readonly string MakefileName = "ISPC.mak";
-	// Target CPU to use for desktop platforms.
+	// Target CPU to use for desktop platforms. Only applies when building for a single target.
 	public static readonly string TargetDesktopCPU = "corei7";
+	// ISPC targets for x64 desktop platforms. The kernels are built for each of them, and ISPC's auto-dispatch picks
+	// the widest one the host supports at startup.
+	public static readonly string[] TargetDesktopISAs = { "sse4-i32x4", "avx2-i32x8", "avx512skx-i32x16" };
 	// Whether to use the ISPC instrumentation.
 	public static bool bUseInstrumentation = false;
 
@@ -78,40 +81,63 @@ public class ShooterGame : ModuleRules
 		return new System.Version(-1, -1, -1);
 	}
 
-	public static string GetISPCFlags(UnrealTargetPlatform Platform, UnrealTargetConfiguration Configuration, bool bInstrumentation)
+	public static string[] GetISPCTargets(UnrealTargetPlatform Platform)
 	{
-		string Flags = "-g";	// We always want debugging symbols.
-		if (bInstrumentation)
-		{
-			Flags += " --instrument";
-		}
 		switch (Platform)
 		{
 			case UnrealTargetPlatform.Win32:
-				Flags += " --target=sse2-i32x4";
-				break;
-			// All relevant x64-based platforms have SSE 4.2.
+				return new string[] { "sse2-i32x4" };
+			// All relevant x64-based platforms have SSE 4.2, and some have more.
 			case UnrealTargetPlatform.Win64:
 			case UnrealTargetPlatform.Mac:
 			case UnrealTargetPlatform.Linux:
 			case UnrealTargetPlatform.AllDesktop:
-				Flags += " --cpu=" + TargetDesktopCPU;
-				Flags += " --target=sse4-i32x4";
-				break;
+				return TargetDesktopISAs;
 			case UnrealTargetPlatform.XboxOne:
 			case UnrealTargetPlatform.PS4:
-				Flags += " --target=sse4-i32x4";
-				break;
+				return new string[] { "sse4-i32x4" };
 			// ARM-based mobiles have NEON.
 			case UnrealTargetPlatform.IOS:
 			case UnrealTargetPlatform.Android:
 			case UnrealTargetPlatform.TVOS:
 			case UnrealTargetPlatform.Switch:
-				Flags += " --target=neon-i32x4";
-				break;
+				return new string[] { "neon-i32x4" };
 			default:
 				throw new System.Exception(string.Format("Platform {0} is unsupported by ISPC", System.Enum.GetName(typeof(UnrealTargetPlatform), Platform)));
 		}
+	}
+
+	// With multiple targets, ISPC emits an object per target next to the dispatch object, suffixed with the target's ISA.
+	public static string[] GetISPCTargetObjectSuffixes(UnrealTargetPlatform Platform)
+	{
+		string[] Targets = GetISPCTargets(Platform);
+		if (Targets.Length < 2)
+		{
+			return new string[0];
+		}
+		string[] Suffixes = new string[Targets.Length];
+		for (int Index = 0; Index < Targets.Length; ++Index)
+		{
+			int Dash = Targets[Index].IndexOf('-');
+			Suffixes[Index] = "_" + (Dash >= 0 ? Targets[Index].Substring(0, Dash) : Targets[Index]);
+		}
+		return Suffixes;
+	}
+
+	// Dependency scanning doesn't care about the targets, so bDependencies only passes the first one.
+	public static string GetISPCFlags(UnrealTargetPlatform Platform, UnrealTargetConfiguration Configuration, bool bInstrumentation, bool bDependencies)
+	{
+		string Flags = "-g";	// We always want debugging symbols.
+		if (bInstrumentation)
+		{
+			Flags += " --instrument";
+		}
+		string[] Targets = GetISPCTargets(Platform);
+		if (Targets == TargetDesktopISAs && (Targets.Length == 1 || bDependencies))
+		{
+			Flags += " --cpu=" + TargetDesktopCPU;
+		}
+		Flags += " --target=" + (bDependencies ? Targets[0] : string.Join(",", Targets));
 		switch (Configuration)
 		{
 			case UnrealTargetConfiguration.Development:
@@ -199,7 +225,8 @@ public class ShooterGame : ModuleRules
 			Makefile.WriteLine();
 
 			Makefile.WriteLine("ISPC=" + GetISPCExecutablePath());
-			Makefile.WriteLine("ISPCFLAGS=" + GetISPCFlags(Target.Platform, Target.Configuration, bUseInstrumentation));
+			Makefile.WriteLine("ISPCFLAGS=" + GetISPCFlags(Target.Platform, Target.Configuration, bUseInstrumentation, false));
+			Makefile.WriteLine("ISPCDEPFLAGS=" + GetISPCFlags(Target.Platform, Target.Configuration, bUseInstrumentation, true));
 			Makefile.WriteLine("SOURCE_DIR=" + ModuleSourceDirectory);
 			Makefile.WriteLine("HEADER_DIR=" + HeaderDir);
 			Makefile.WriteLine();
@@ -222,6 +249,10 @@ public class ShooterGame : ModuleRules
 				AbsoluteSources.Add(AbsSource);
 				Objects.Add(Object);
 				AbsoluteObjects.Add(AbsObject);
+				foreach (string Suffix in GetISPCTargetObjectSuffixes(Target.Platform))
+				{
+					AbsoluteObjects.Add(Path.Combine(ObjectDir, Object.Replace(".o", Suffix + ".o")));
+				}
 				Headers.Add(AbsHeader);
 				Dependencies.Add(Dependency);
 
@@ -240,7 +271,7 @@ public class ShooterGame : ModuleRules
 
 					Makefile.WriteLine("# ISPC object dependency file.");
 					Makefile.WriteLine("{0}: \"$(SOURCE_DIR){1}\"", Dependency, Path.DirectorySeparatorChar + RelativeSource);
-					Makefile.WriteLine("\t$(ISPC) $? -M -MF $@ -MT {0} --wno-perf $(ISPCFLAGS)", Object);
+					Makefile.WriteLine("\t$(ISPC) $? -M -MF $@ -MT {0} --wno-perf $(ISPCDEPFLAGS)", Object);
 
 				Makefile.WriteLine(bUseGNUMake ? "endif" : "!ENDIF");
 
@@ -292,6 +323,14 @@ public class ShooterGame : ModuleRules
 	{
 		SetModuleRulesFromISPC(Target);
 
+		// Lets the C++ side know whether to collect the ISPCInstrument() data.
+		PrivateDefinitions.Add("ISPC_INSTRUMENTATION=" + (bUseInstrumentation ? "1" : "0"));
+		// Lets the C++ side call each target's kernels directly, see ISPCKernelTargets.h.
+		foreach (string Suffix in GetISPCTargetObjectSuffixes(Target.Platform))
+		{
+			PrivateDefinitions.Add("ISPC_HAS_TARGET" + Suffix.ToUpperInvariant() + "=1");
+		}
+
 		PrivateIncludePaths.AddRange(
 			new string[] { 
 				"ShooterGame/Classes/Player",